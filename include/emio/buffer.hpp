@@ -12,6 +12,7 @@
 #include <utility>
 
 #if __STDC_HOSTED__
+#  include <memory_resource>
 #  include <string>
 #endif
 
@@ -80,15 +81,54 @@ class buffer {
     return area;
   }
 
+  /**
+   * Releases the end of the most recently returned write area, which hasn't been written.
+   * @note This function allows to request a write area of an upper bound size and to return the unused part afterwards.
+   * No other write area must be requested in between.
+   * @param size The number of unwritten chars at the end of the write area.
+   */
+  constexpr void release_write_area(const size_t size) noexcept {
+    EMIO_Z_DEV_ASSERT(size <= used_);
+    used_ -= size;
+  }
+
+  /**
+   * Returns the size of the write area which can be returned without requesting a new one from the subclass.
+   * @note This function allows to request an upper bound size only if it doesn't make the buffer grow.
+   * @return The remaining size of the current write area.
+   */
+  [[nodiscard]] constexpr size_t get_remaining_write_area_size() const noexcept {
+    return area_.size() - used_;
+  }
+
+  /**
+   * Tries to reference a literal of a format string instead of copying it into a write area.
+   * @param str The literal. Must stay valid until the buffer is flushed.
+   * @return True if the literal is referenced, false if it must be written into a write area or eof if the buffer
+   * failed to make room for the reference.
+   */
+  constexpr result<bool> try_reference_literal(const std::string_view str) noexcept {
+    if (literal_reference_ == literal_reference::no) {
+      return false;
+    }
+    return request_literal_reference(used_, str);
+  }
+
  protected:
   /// Flag to indicate if the buffer's size is fixed and cannot grow.
   enum class fixed_size : bool { no, yes };
 
+  /// Flag to indicate if the buffer can reference literals of format strings instead of copying them.
+  enum class literal_reference : bool { no, yes };
+
   /**
    * Constructs the buffer.
    * @brief fixed Flag to indicate if the buffer's size is fixed and cannot grow.
+   * @brief reference Flag to indicate if the buffer can reference literals of format strings.
    */
-  constexpr explicit buffer(fixed_size fixed = fixed_size::no) noexcept : fixed_size_{fixed} {}
+  constexpr explicit buffer(fixed_size fixed = fixed_size::no,
+                            literal_reference reference = literal_reference::no) noexcept
+      : fixed_size_{fixed}, literal_reference_{reference} {}
 
   /**
    * Requests a write area of the given size from a subclass.
@@ -102,6 +142,20 @@ class buffer {
     return err::eof;
   }
 
+  /**
+   * Requests a subclass to reference a literal instead of copying it into a write area.
+   * @note Only called if the buffer has been constructed with literal_reference::yes.
+   * @param used Already written characters into the current write area.
+   * @param str The literal. Stays valid until the buffer is flushed.
+   * @return True if the literal is referenced, false if it must be written into a write area or eof if no room for
+   * the reference is available.
+   */
+  virtual constexpr result<bool> request_literal_reference(const size_t used, const std::string_view str) noexcept {
+    static_cast<void>(used);  // Keep params for documentation.
+    static_cast<void>(str);
+    return false;
+  }
+
   /**
    * Sets a new write area in the base class object to use.
    * @param area The new write area.
@@ -121,6 +175,7 @@ class buffer {
 
  private:
   fixed_size fixed_size_{fixed_size::no};
+  literal_reference literal_reference_{literal_reference::no};
   size_t used_{};
   std::span<char> area_{};
 };
@@ -128,10 +183,14 @@ class buffer {
 /**
  * This class fulfills the buffer API by providing an endless growing buffer.
  * @tparam StorageSize The size of the internal storage used for small buffer optimization.
+ * @tparam Allocator The allocator used if the buffer grows beyond the internal storage.
  */
-template <size_t StorageSize = default_cache_size>
+template <size_t StorageSize = default_cache_size, typename Allocator = std::allocator<char>>
 class memory_buffer final : public buffer {
  public:
+  /// The allocator type.
+  using allocator_type = Allocator;
+
   /**
    * Constructs and initializes the buffer with the internal storage size.
    */
@@ -141,7 +200,20 @@ class memory_buffer final : public buffer {
    * Constructs and initializes the buffer with the given capacity.
    * @param capacity The initial capacity.
    */
-  constexpr explicit memory_buffer(const size_t capacity) noexcept {
+  constexpr explicit memory_buffer(const size_t capacity) noexcept : memory_buffer{capacity, Allocator()} {}
+
+  /**
+   * Constructs and initializes the buffer with the internal storage size and the given allocator.
+   * @param alloc The allocator.
+   */
+  constexpr explicit memory_buffer(const Allocator& alloc) noexcept : memory_buffer{0, alloc} {}
+
+  /**
+   * Constructs and initializes the buffer with the given capacity and allocator.
+   * @param capacity The initial capacity.
+   * @param alloc The allocator.
+   */
+  constexpr memory_buffer(const size_t capacity, const Allocator& alloc) noexcept : vec_{alloc} {
     // Request at least the internal storage size. Should never fail.
     request_write_area(0, std::max(vec_.capacity(), capacity)).value();
   }
@@ -151,12 +223,36 @@ class memory_buffer final : public buffer {
     this->set_write_area({vec_.data() + used_, vec_.data() + vec_.capacity()});
   }
 
+  /**
+   * Constructs the buffer as copy of another buffer with the given allocator.
+   * @param other The other buffer.
+   * @param alloc The allocator.
+   */
+  constexpr memory_buffer(const memory_buffer& other, const Allocator& alloc)
+      : buffer{}, used_{other.used_ + other.get_used_count()}, vec_{other.vec_, alloc} {
+    this->set_write_area({vec_.data() + used_, vec_.data() + vec_.capacity()});
+  }
+
   constexpr memory_buffer(memory_buffer&& other) noexcept
       : buffer{}, used_{other.used_ + other.get_used_count()}, vec_{std::move(other).vec_} {
     this->set_write_area({vec_.data() + used_, vec_.data() + vec_.capacity()});
     other.reset();
   }
 
+  /**
+   * Constructs the buffer by moving another buffer with the given allocator. The storage of the other buffer is only
+   * adopted if it belongs to the same allocator.
+   * @param other The other buffer.
+   * @param alloc The allocator.
+   */
+  constexpr memory_buffer(memory_buffer&& other, const Allocator& alloc) noexcept(
+      std::is_nothrow_constructible_v<detail::ct_vector<char, StorageSize, Allocator>,
+                                      detail::ct_vector<char, StorageSize, Allocator>&&, const Allocator&>)
+      : buffer{}, used_{other.used_ + other.get_used_count()}, vec_{std::move(other).vec_, alloc} {
+    this->set_write_area({vec_.data() + used_, vec_.data() + vec_.capacity()});
+    other.reset();
+  }
+
   constexpr memory_buffer& operator=(const memory_buffer& other) {
     if (&other == this) {
       return *this;
@@ -168,7 +264,8 @@ class memory_buffer final : public buffer {
     return *this;
   }
 
-  constexpr memory_buffer& operator=(memory_buffer&& other) noexcept {
+  constexpr memory_buffer& operator=(memory_buffer&& other) noexcept(
+      std::is_nothrow_move_assignable_v<detail::ct_vector<char, StorageSize, Allocator>>) {
     if (&other == this) {
       return *this;
     }
@@ -217,6 +314,14 @@ class memory_buffer final : public buffer {
     return vec_.capacity();
   }
 
+  /**
+   * Returns the allocator of the buffer.
+   * @return The allocator.
+   */
+  [[nodiscard]] constexpr allocator_type get_allocator() const noexcept {
+    return vec_.get_allocator();
+  }
+
  protected:
   constexpr result<std::span<char>> request_write_area(const size_t used, const size_t size) noexcept override {
     const size_t new_size = vec_.size() + size;
@@ -229,9 +334,26 @@ class memory_buffer final : public buffer {
 
  private:
   size_t used_{};
-  detail::ct_vector<char, StorageSize> vec_{};
+  detail::ct_vector<char, StorageSize, Allocator> vec_;
 };
 
+#if __STDC_HOSTED__
+
+namespace pmr {
+
+/**
+ * A memory_buffer which allocates from a std::pmr::memory_resource if it grows beyond the internal storage. E.g. a
+ * std::pmr::monotonic_buffer_resource turns the growth into a bump-pointer allocation and releases all buffers of a
+ * scope at once.
+ * @tparam StorageSize The size of the internal storage used for small buffer optimization.
+ */
+template <size_t StorageSize = default_cache_size>
+using memory_buffer = emio::memory_buffer<StorageSize, std::pmr::polymorphic_allocator<char>>;
+
+}  // namespace pmr
+
+#endif
+
 /**
  * This class fulfills the buffer API by using a span over an contiguous range.
  */
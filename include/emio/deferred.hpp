@@ -0,0 +1,119 @@
+//
+// Copyright (c) 2021 - present, Toni Neubert
+// All rights reserved.
+//
+// For the license information refer to emio.hpp
+
+#pragma once
+
+#include <cstring>
+#include <string_view>
+#include <tuple>
+
+#include "format.hpp"
+
+namespace emio {
+
+namespace detail::format {
+
+// Restores the arguments from the payload of a record and formats them.
+using deferred_format_fn = result<void> (*)(writer& out, std::string_view str, const char* payload) noexcept;
+
+/**
+ * The header of a binary record of a deferred formatting. It is followed by the serialized arguments.
+ */
+struct deferred_record_header {
+  size_t size{};                ///< The total size of the record including this header.
+  deferred_format_fn format{};  ///< The identity of the argument types. Instantiated per argument types.
+  const char* str_data{};       ///< The data of the validated format string.
+  size_t str_size{};            ///< The size of the validated format string.
+  bool plain_str{};             ///< If the format string has no escape sequences or replacement fields.
+};
+
+static_assert(std::is_trivially_copyable_v<deferred_record_header>);
+
+template <typename... Args>
+result<void> format_deferred_args(writer& out, std::string_view str, [[maybe_unused]] const char* payload) noexcept {
+  // The braced initialization guarantees that the arguments are restored from left to right.
+  const std::tuple<typename serialize_arg_trait<Args>::restored_type...> restored{
+      serialize_arg_trait<Args>::deserialize(payload)...};
+  return std::apply(
+      [&](const auto&... values) noexcept {
+        return parse<format_parser>(str, out, values...);
+      },
+      restored);
+}
+
+}  // namespace detail::format
+
+/**
+ * Determines the size of the binary record which captures the format string and the arguments.
+ * @param format_str The format string.
+ * @param args The arguments to be captured.
+ * @return The size of the record.
+ */
+template <typename... Args>
+  requires(detail::format::is_serializable_v<Args> && ...)
+[[nodiscard]] size_t deferred_size(const emio::format_string<Args...>& /*format_str*/, const Args&... args) noexcept {
+  return (sizeof(detail::format::deferred_record_header) + ... + detail::format::serialize_arg_trait<Args>::size(args));
+}
+
+/**
+ * Captures the format string and the arguments into a binary record instead of formatting them. The record is written
+ * contiguously into the buffer and can be formatted later (e.g. by another thread) with format_deferred_to.
+ * Only arguments which are unified to a core type (bools, chars, integers, floating-points, pointers and strings) can
+ * be captured. The chars of strings are copied into the record.
+ * @note The record references the format string, which must outlive the record. The record is in the native
+ * representation and can only be formatted by the same program.
+ * @param buf The output buffer.
+ * @param format_str The format string.
+ * @param args The arguments to be captured.
+ * @return Success or EOF if the buffer is to small or invalid_format if the format string validation failed.
+ */
+template <typename... Args>
+  requires(detail::format::is_serializable_v<Args> && ...)
+result<void> defer_to(buffer& buf, const emio::format_string<Args...>& format_str, const Args&... args) noexcept {
+  EMIO_TRY(const std::string_view str, format_str.get());
+
+  const detail::format::deferred_record_header header{
+      .size = emio::deferred_size(format_str, args...),
+      .format = &detail::format::format_deferred_args<Args...>,
+      .str_data = str.data(),
+      .str_size = str.size(),
+      .plain_str = format_str.is_plain_str(),
+  };
+  EMIO_TRY(const std::span<char> area, buf.get_write_area_of(header.size));
+  char* out = area.data();
+  std::memcpy(out, &header, sizeof(header));
+  out += sizeof(header);
+  ((out = detail::format::serialize_arg_trait<Args>::serialize(out, args)), ...);
+  return success;
+}
+
+/**
+ * Formats the first binary record captured by defer_to, and writes the result to the output buffer.
+ * @param buf The output buffer.
+ * @param records The bytes starting with the record. Further records may follow.
+ * @return The size of the formatted record on success or EOF if the buffer is to small or invalid_data if the bytes
+ * don't contain a whole record.
+ */
+inline result<size_t> format_deferred_to(buffer& buf, std::string_view records) noexcept {
+  detail::format::deferred_record_header header;
+  if (records.size() < sizeof(header)) {
+    return err::invalid_data;
+  }
+  std::memcpy(&header, records.data(), sizeof(header));
+  if (header.size < sizeof(header) || records.size() < header.size) {
+    return err::invalid_data;
+  }
+  const std::string_view str{header.str_data, header.str_size};
+  writer wtr{buf};
+  if (header.plain_str) {
+    EMIO_TRYV(wtr.write_literal(str));
+  } else {
+    EMIO_TRYV(header.format(wtr, str, records.data() + sizeof(header)));
+  }
+  return header.size;
+}
+
+}  // namespace emio
@@ -67,28 +67,30 @@ inline constexpr carrying_mul_result_t carrying_mul(uint32_t a, uint32_t b, uint
 }
 
 /// Stack-allocated arbitrary-precision (up to certain limit) integer.
-class bignum {
+/// @tparam MaxBlocks The maximal number of 32-bit blocks.
+template <size_t MaxBlocks>
+class basic_bignum {
  public:
-  static constexpr size_t max_blocks = 34;
+  static constexpr size_t max_blocks = MaxBlocks;
 
-  static constexpr bignum from(size_t sz, const std::array<uint32_t, max_blocks>& b) noexcept {
-    bignum bn{};
+  static constexpr basic_bignum from(size_t sz, const std::array<uint32_t, max_blocks>& b) noexcept {
+    basic_bignum bn{};
     bn.size_ = sz;
     bn.base_ = b;
     return bn;
   }
 
-  constexpr explicit bignum() noexcept = default;
+  constexpr explicit basic_bignum() noexcept = default;
 
   /// Makes a bignum from one digit.
   template <typename T>
     requires(std::is_unsigned_v<T> && sizeof(T) <= sizeof(uint32_t))
-  constexpr explicit bignum(T v) noexcept : base_{{v}} {}
+  constexpr explicit basic_bignum(T v) noexcept : base_{{v}} {}
 
   /// Makes a bignum from `u64` value.
   template <typename T>
     requires(std::is_unsigned_v<T> && sizeof(T) == sizeof(uint64_t))
-  constexpr explicit bignum(T v) noexcept : base_{{static_cast<uint32_t>(v), static_cast<uint32_t>(v >> 32)}} {
+  constexpr explicit basic_bignum(T v) noexcept : base_{{static_cast<uint32_t>(v), static_cast<uint32_t>(v >> 32)}} {
     size_ += static_cast<size_t>(base_[1] > 0);
   }
 
@@ -117,11 +119,11 @@ class bignum {
 
   // add
   // add_small
-  constexpr bignum& add_small(uint32_t other) noexcept {
+  constexpr basic_bignum& add_small(uint32_t other) noexcept {
     return add_small_at(0, other);
   }
 
-  constexpr bignum& add_small_at(size_t index, uint32_t other) noexcept {
+  constexpr basic_bignum& add_small_at(size_t index, uint32_t other) noexcept {
     size_t i = index;
     auto res = carrying_add(base_[i], other, false);
     base_[i] = res.value;
@@ -131,11 +133,13 @@ class bignum {
       base_[i] = res.value;
     }
     EMIO_Z_DEV_ASSERT(!res.carry);
-    size_ = i;
+    if (i > size_) {
+      size_ = i;
+    }
     return *this;
   }
 
-  constexpr bignum& add(const bignum& other) noexcept {
+  constexpr basic_bignum& add(const basic_bignum& other) noexcept {
     carrying_add_result_t res{0, false};
     size_t i = 0;
     for (; (i < other.size_) || (res.carry && (i < base_.size())); i++) {
@@ -150,7 +154,7 @@ class bignum {
   }
 
   /// Subtracts `other` from itself and returns its own mutable reference.
-  constexpr bignum& sub_small(uint32_t other) noexcept {
+  constexpr basic_bignum& sub_small(uint32_t other) noexcept {
     auto res = borrowing_sub(base_[0], other, false);
     base_[0] = res.value;
     size_t i = 1;
@@ -166,7 +170,7 @@ class bignum {
   }
 
   /// Subtracts `other` from itself and returns its own mutable reference.
-  constexpr bignum& sub(const bignum& other) noexcept {
+  constexpr basic_bignum& sub(const basic_bignum& other) noexcept {
     EMIO_Z_DEV_ASSERT(size_ >= other.size_);
     if (size_ == 0) {
       return *this;
@@ -187,11 +191,11 @@ class bignum {
 
   /// Multiplies itself by a digit-sized `other` and returns its own
   /// mutable reference.
-  constexpr bignum& mul_small(uint32_t other) noexcept {
+  constexpr basic_bignum& mul_small(uint32_t other) noexcept {
     return muladd_small(other, 0);
   }
 
-  constexpr bignum& muladd_small(uint32_t other, uint32_t carry) noexcept {
+  constexpr basic_bignum& muladd_small(uint32_t other, uint32_t carry) noexcept {
     carrying_mul_result_t res{0, carry};
     for (size_t i = 0; i < size_; i++) {
       res = carrying_mul(base_[i], other, res.carry);
@@ -204,11 +208,11 @@ class bignum {
     return *this;
   }
 
-  [[nodiscard]] bignum mul(const bignum& other) const noexcept {
+  [[nodiscard]] basic_bignum mul(const basic_bignum& other) const noexcept {
     const auto& bn_max = size_ > other.size_ ? *this : other;
     const auto& bn_min = size_ > other.size_ ? other : *this;
 
-    bignum prod{};
+    basic_bignum prod{};
     for (size_t i = 0; i < bn_min.size_; i++) {
       carrying_mul_result_t res{0, 0};
       for (size_t j = 0; j < bn_max.size_; j++) {
@@ -222,11 +226,11 @@ class bignum {
     return prod;
   }
 
-  constexpr bignum& mul_digits(std::span<const uint32_t> other) noexcept {
+  constexpr basic_bignum& mul_digits(std::span<const uint32_t> other) noexcept {
     const auto& bn_max = size_ > other.size() ? digits() : other;
     const auto& bn_min = size_ > other.size() ? other : digits();
 
-    bignum prod{};
+    basic_bignum prod{};
     for (size_t i = 0; i < bn_min.size(); i++) {
       carrying_mul_result_t res{0, 0};
       for (size_t j = 0; j < bn_max.size(); j++) {
@@ -242,7 +246,7 @@ class bignum {
   }
 
   /// Multiplies itself by `5^e` and returns its own mutable reference.
-  constexpr bignum& mul_pow5(size_t k) noexcept {
+  constexpr basic_bignum& mul_pow5(size_t k) noexcept {
     // Multiply with the largest single-digit power as long as possible.
     while (k >= 13) {
       mul_small(1220703125);
@@ -274,7 +278,7 @@ class bignum {
   }
 
   /// Multiplies itself by `2^exp` and returns its own mutable reference.
-  constexpr bignum& mul_pow2(size_t exp) noexcept {
+  constexpr basic_bignum& mul_pow2(size_t exp) noexcept {
     const size_t digits = exp / 32;
     const size_t bits = exp % 32;
 
@@ -303,7 +307,7 @@ class bignum {
     return *this;
   }
 
-  [[nodiscard]] constexpr std::strong_ordering operator<=>(const bignum& other) const noexcept {
+  [[nodiscard]] constexpr std::strong_ordering operator<=>(const basic_bignum& other) const noexcept {
     if (size_ > other.size_) {
       return std::strong_ordering::greater;
     }
@@ -321,7 +325,7 @@ class bignum {
     return std::strong_ordering::equal;
   }
 
-  constexpr bool operator==(const bignum& other) const noexcept = default;
+  constexpr bool operator==(const basic_bignum& other) const noexcept = default;
 
  private:
   /// Number of "digits" used in base_.
@@ -331,4 +335,7 @@ class bignum {
   std::array<uint32_t, max_blocks> base_{};
 };
 
+/// The bignum used by the floating-point formatting algorithms.
+using bignum = basic_bignum<34>;
+
 }  // namespace emio::detail
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <bit>
 #include <cstdint>
 #include <cstring>
@@ -39,8 +41,10 @@ constexpr std::optional<int> char_to_digit(const char c, const int base) noexcep
     res = c - 'a' + 10;
   } else if (c >= 'A') {
     res = c - 'A' + 10;
-  } else {
+  } else if (c <= '9') {
     res = c - '0';
+  } else {
+    return std::nullopt;
   }
   if (res < base) {
     return res;
@@ -48,6 +52,112 @@ constexpr std::optional<int> char_to_digit(const char c, const int base) noexcep
   return std::nullopt;
 }
 
+#if !defined(EMIO_OPTIMIZE_FOR_SIZE)
+
+// SWAR (SIMD within a register) helpers to validate and convert up to 8 digits at once. The chars are loaded in
+// little-endian order, so byte i of a chunk is the i-th char of the input.
+
+inline constexpr bool is_swar_supported = std::endian::native == std::endian::little;
+
+inline constexpr size_t swar_chunk_size = sizeof(uint64_t);
+
+constexpr uint64_t swar_broadcast(const uint8_t byte) noexcept {
+  return uint64_t{0x0101'0101'0101'0101} * byte;
+}
+
+// Sets the high bit of each byte which is in [lo, hi]. Only valid for ASCII bytes, other bytes may corrupt the result
+// of the following bytes.
+constexpr uint64_t swar_in_range(const uint64_t chunk, const uint8_t lo, const uint8_t hi) noexcept {
+  return (chunk + swar_broadcast(static_cast<uint8_t>(0x80 - lo))) &
+         ~(chunk + swar_broadcast(static_cast<uint8_t>(0x7F - hi))) & swar_broadcast(0x80);
+}
+
+// Returns the number of leading decimal (Base = 10) or hexadecimal (Base = 16) digits of the chunk.
+template <int Base>
+constexpr size_t swar_count_digits(const uint64_t chunk) noexcept {
+  uint64_t digits = swar_in_range(chunk, '0', '9');
+  if constexpr (Base == 16) {
+    digits |= swar_in_range(chunk, 'a', 'f') | swar_in_range(chunk, 'A', 'F');
+  }
+  digits &= ~chunk;  // Exclude non ASCII bytes.
+  return static_cast<size_t>(std::countr_zero(~digits & swar_broadcast(0x80))) / 8;
+}
+
+// Converts the first n (1 - 8) decimal digits of the chunk.
+constexpr uint32_t swar_parse_decimal(uint64_t chunk, const size_t n) noexcept {
+  chunk <<= 8 * (swar_chunk_size - n);  // Discard the following chars. The shifted in zeros become leading zeros.
+  chunk = ((chunk & swar_broadcast(0x0F)) * (10 * 256 + 1)) >> 8;
+  chunk = ((chunk & 0x00FF'00FF'00FF'00FF) * (100 * 65536 + 1)) >> 16;
+  return static_cast<uint32_t>(((chunk & 0x0000'FFFF'0000'FFFF) * (10000 * (uint64_t{1} << 32) + 1)) >> 32);
+}
+
+// Converts the first n (1 - 8) hexadecimal digits of the chunk.
+constexpr uint32_t swar_parse_hex(uint64_t chunk, const size_t n) noexcept {
+  chunk <<= 8 * (swar_chunk_size - n);
+  // Letters have bit 6 set ('A' = 0x41, 'a' = 0x61) and their lower nibble is one less than their value - 9.
+  chunk = (chunk & swar_broadcast(0x0F)) + ((chunk >> 6) & swar_broadcast(0x01)) * 9;
+  // Merge the nibbles. The first char is the most significant one.
+  chunk = ((chunk << 4) | (chunk >> 8)) & 0x00FF'00FF'00FF'00FF;
+  chunk = ((chunk << 8) | (chunk >> 16)) & 0x0000'FFFF'0000'FFFF;
+  return static_cast<uint32_t>((chunk << 16) | (chunk >> 32));
+}
+
+inline constexpr std::array<uint32_t, 9> swar_pow10{1, 10, 100, 1'000, 10'000, 100'000, 1'000'000, 10'000'000,
+                                                    100'000'000};
+
+/**
+ * Parses the decimal or hexadecimal digits of an unsigned integer up to 8 digits at once.
+ * @param it The begin of the input. Is moved after the digits on success.
+ * @param end The end of the input.
+ * @return The value or std::nullopt if there is no digit or if there are too many digits to parse them without
+ * overflow. Then, the input has to be parsed char by char.
+ */
+template <int Base>
+inline std::optional<uint64_t> parse_uint_swar(const char*& it, const char* const end) noexcept {
+  // More digits could overflow an uint64_t.
+  constexpr size_t max_digits = Base == 10 ? 19 : 16;
+
+  const char* next = it;
+  uint64_t value{};
+  size_t digit_cnt{};
+  while (true) {
+    const auto remaining = static_cast<size_t>(end - next);
+    uint64_t chunk{};
+    if (remaining >= swar_chunk_size) {
+      std::memcpy(&chunk, next, swar_chunk_size);
+    } else {
+      // Missing chars are zero (no digit). A loop avoids a call to memcpy with a dynamic size.
+      for (size_t i = 0; i < remaining; i++) {
+        chunk |= uint64_t{static_cast<uint8_t>(next[i])} << (8 * i);
+      }
+    }
+    const size_t n = swar_count_digits<Base>(chunk);
+    if (n == 0) {
+      break;
+    }
+    digit_cnt += n;
+    if (digit_cnt > max_digits) {
+      return std::nullopt;
+    }
+    if constexpr (Base == 10) {
+      value = value * swar_pow10[n] + swar_parse_decimal(chunk, n);
+    } else {
+      value = (value << (4 * n)) | swar_parse_hex(chunk, n);
+    }
+    next += n;
+    if (n != swar_chunk_size) {
+      break;
+    }
+  }
+  if (digit_cnt == 0) {
+    return std::nullopt;
+  }
+  it = next;
+  return value;
+}
+
+#endif
+
 constexpr char digit_to_char(const int digit, bool upper) noexcept {
   if (digit >= 10) {
     EMIO_Z_DEV_ASSERT(digit < 36);
@@ -60,9 +170,48 @@ constexpr char digit_to_char(const int digit, bool upper) noexcept {
   return static_cast<char>(static_cast<int>('0') + digit);
 }
 
+#if !defined(EMIO_OPTIMIZE_FOR_SIZE)
+
+// The maximum number of decimal digits of a number with a given bit width.
+inline constexpr std::array<uint8_t, 65> max_digits_of_bit_width{
+    1,  1,  1,  1,  2,  2,  2,  3,  3,  3,  4,  4,  4,  4,  5,  5,  5,  6,  6,  6,  7,  7,
+    7,  7,  8,  8,  8,  9,  9,  9,  10, 10, 10, 10, 11, 11, 11, 12, 12, 12, 13, 13, 13, 13,
+    14, 14, 14, 15, 15, 15, 16, 16, 16, 16, 17, 17, 17, 18, 18, 18, 19, 19, 19, 19, 20};
+
+// The smallest number with n + 1 decimal digits (except for n = 0).
+inline constexpr std::array<uint64_t, 20> min_number_of_digits{
+    0,
+    10,
+    100,
+    1'000,
+    10'000,
+    100'000,
+    1'000'000,
+    10'000'000,
+    100'000'000,
+    1'000'000'000,
+    10'000'000'000,
+    100'000'000'000,
+    1'000'000'000'000,
+    10'000'000'000'000,
+    100'000'000'000'000,
+    1'000'000'000'000'000,
+    10'000'000'000'000'000,
+    100'000'000'000'000'000,
+    1'000'000'000'000'000'000,
+    10'000'000'000'000'000'000U,
+};
+
+#endif
+
 template <typename T>
-  requires(std::is_unsigned_v<T>)
+  requires(std::is_unsigned_v<T> && std::numeric_limits<T>::digits <= 64)
 constexpr size_t count_digits_10(T number) noexcept {
+#if !defined(EMIO_OPTIMIZE_FOR_SIZE)
+  // Numbers of the same bit width have either the maximum number of digits or one less.
+  const size_t digits = max_digits_of_bit_width[static_cast<size_t>(std::bit_width(number | 1U))];
+  return digits - static_cast<size_t>(number < min_number_of_digits[digits - 1]);
+#else
   size_t count = 1;
   for (;;) {
     // Integer division is slow so do it for a group of four digits instead
@@ -83,6 +232,22 @@ constexpr size_t count_digits_10(T number) noexcept {
     number /= 10000U;
     count += 4;
   }
+#endif
+}
+
+template <typename T>
+  requires(std::is_unsigned_v<T> && std::numeric_limits<T>::digits > 64)
+constexpr size_t count_digits_10(T number) noexcept {
+  if (number <= std::numeric_limits<uint64_t>::max()) {
+    return count_digits_10(static_cast<uint64_t>(number));
+  }
+  // Numbers greater than 2^64 have at least 20 digits. The remaining powers of ten are compared one by one.
+  constexpr size_t max_digits = std::numeric_limits<T>::digits10 + 1;
+  size_t count = 20;
+  for (T power = T{10'000'000'000'000'000'000U} * 10U; count < max_digits && number >= power; power *= 10U) {
+    ++count;
+  }
+  return count;
 }
 
 template <size_t Base, typename T>
@@ -148,11 +313,27 @@ constexpr int num_bits() noexcept {
   return std::numeric_limits<T>::digits;
 }
 
+// 128-bit integers (__int128) keep their size. They are supported if the standard library treats them as integral types
+// (e.g. libstdc++ with GNU extensions or libc++).
 template <typename T>
-using int32_or_64 = std::conditional_t<num_bits<T>() <= 32, int32_t, int64_t>;
+using int32_or_64 =
+    typename std::conditional_t<num_bits<T>() <= 32, std::type_identity<int32_t>,
+                                std::conditional_t<num_bits<T>() <= 64, std::type_identity<int64_t>,
+                                                   std::make_signed<T>>>::type;
 
 template <typename T>
-using uint32_or_64 = std::conditional_t<num_bits<T>() <= 32, uint32_t, uint64_t>;
+using uint32_or_64 =
+    typename std::conditional_t<num_bits<T>() <= 32, std::type_identity<uint32_t>,
+                                std::conditional_t<num_bits<T>() <= 64, std::type_identity<uint64_t>,
+                                                   std::make_unsigned<T>>>::type;
+
+// Checks if T is a 128-bit integer supported by the standard library.
+template <typename T>
+inline constexpr bool is_int128_v = false;
+
+template <typename T>
+  requires(std::is_integral_v<T>)
+inline constexpr bool is_int128_v<T> = num_bits<T>() > 64;
 
 template <typename T>
 using upcasted_int_t = std::conditional_t<std::is_signed_v<T>, int32_or_64<T>, uint32_or_64<T>>;
@@ -208,10 +389,70 @@ inline constexpr void copy2(Char* dst, const char* src) noexcept {
   }
 }
 
+#if !defined(EMIO_OPTIMIZE_FOR_SIZE)
+
+// Divides a value < 10^8 by 100 with a multiply-shift sequence.
+inline constexpr uint32_t div100(const uint32_t value) noexcept {
+  return static_cast<uint32_t>((uint64_t{value} * 1'374'389'535U) >> 37);
+}
+
+// Divides a value < 10^8 by 10000 with a multiply-shift sequence.
+inline constexpr uint32_t div10000(const uint32_t value) noexcept {
+  return static_cast<uint32_t>((uint64_t{value} * 109'951'163U) >> 40);
+}
+
+// Writes the four digits (including leading zeros) of a value < 10^4 from right to left.
+inline constexpr char* write_4_digits(const uint32_t value, char* next) noexcept {
+  const uint32_t high = div100(value);
+  next -= 4;
+  copy2(next, digits2(high));
+  copy2(next + 2, digits2(value - high * 100));
+  return next;
+}
+
+// Writes the eight digits (including leading zeros) of a value < 10^8 from right to left.
+inline constexpr char* write_8_digits(const uint32_t value, char* next) noexcept {
+  const uint32_t high = div10000(value);
+  next = write_4_digits(value - high * 10000, next);
+  return write_4_digits(high, next);
+}
+
+#endif
+
 template <typename T>
-  requires(std::is_unsigned_v<T>)
+  requires(std::is_unsigned_v<T> && std::numeric_limits<T>::digits <= 64)
 constexpr char* write_decimal(T abs_number, char* next) noexcept {
   // Write number from right to left.
+#if !defined(EMIO_OPTIMIZE_FOR_SIZE)
+  // Split the number into independent blocks of eight digits, which are converted without divisions. This avoids the
+  // long dependency chain of dividing the whole number by 100 for every two digits.
+  if constexpr (std::numeric_limits<T>::max() >= 100'000'000) {
+    while (abs_number >= 100'000'000) {
+      const T high = abs_number / 100'000'000;
+      next = write_8_digits(static_cast<uint32_t>(abs_number - high * 100'000'000), next);
+      abs_number = high;
+    }
+  }
+  auto value = static_cast<uint32_t>(abs_number);
+  if (value >= 10000) {
+    const uint32_t high = div10000(value);
+    next = write_4_digits(value - high * 10000, next);
+    value = high;
+  }
+  if (value >= 100) {
+    const uint32_t high = div100(value);
+    next -= 2;
+    copy2(next, digits2(value - high * 100));
+    value = high;
+  }
+  if (value < 10) {
+    *--next = static_cast<char>('0' + value);
+    return next;
+  }
+  next -= 2;
+  copy2(next, digits2(value));
+  return next;
+#else
   while (abs_number >= 100) {
     next -= 2;
     copy2(next, digits2(static_cast<size_t>(abs_number % 100)));
@@ -224,6 +465,26 @@ constexpr char* write_decimal(T abs_number, char* next) noexcept {
   next -= 2;
   copy2(next, digits2(static_cast<size_t>(abs_number)));
   return next;
+#endif
+}
+
+template <typename T>
+  requires(std::is_unsigned_v<T> && std::numeric_limits<T>::digits > 64)
+constexpr char* write_decimal(T abs_number, char* next) noexcept {
+  // Split the number into blocks of 19 digits, which fit into 64 bits and are written by the 64-bit algorithm. Each
+  // block requires only a division of the 128-bit number by a 64-bit divisor.
+  constexpr uint64_t block_divisor{10'000'000'000'000'000'000U};
+  constexpr size_t block_digits = 19;
+  while (abs_number > std::numeric_limits<uint64_t>::max()) {
+    const T high = abs_number / block_divisor;
+    char* const block_begin = next - block_digits;
+    next = write_decimal(static_cast<uint64_t>(abs_number - high * block_divisor), next);
+    while (next != block_begin) {
+      *--next = '0';
+    }
+    abs_number = high;
+  }
+  return write_decimal(static_cast<uint64_t>(abs_number), next);
 }
 
 template <size_t BaseBits, typename T>
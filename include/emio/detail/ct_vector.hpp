@@ -9,6 +9,8 @@
 #include <algorithm>
 #include <array>
 #include <cstddef>
+#include <memory>
+#include <utility>
 
 #include "conversion.hpp"
 #include "predef.hpp"
@@ -19,54 +21,81 @@ namespace emio::detail {
  * A constexpr vector with the bare minimum implementation and inlined storage.
  * @tparam Char The character type.
  * @tparam StorageSize The size of the inlined storage.
+ * @tparam Allocator The allocator of the external storage.
  */
-template <typename Char, size_t StorageSize = 128>
+template <typename Char, size_t StorageSize = 128, typename Allocator = std::allocator<Char>>
 class ct_vector {
+  using alloc_traits = std::allocator_traits<Allocator>;
+
  public:
-  constexpr ct_vector() noexcept {
+  constexpr ct_vector() noexcept : ct_vector{Allocator()} {}
+
+  constexpr explicit ct_vector(const Allocator& alloc) noexcept : alloc_{alloc} {
     if (EMIO_Z_INTERNAL_IS_CONST_EVAL) {
       fill_n(storage_.data(), storage_.size(), 0);
     }
   }
 
-  constexpr ct_vector(const ct_vector& other) : ct_vector() {
+  constexpr ct_vector(const ct_vector& other)
+      : ct_vector{other, alloc_traits::select_on_container_copy_construction(other.alloc_)} {}
+
+  constexpr ct_vector(const ct_vector& other, const Allocator& alloc) : ct_vector{alloc} {
     reserve(other.size_);
     copy_n(other.data_, other.size_, data_);
   }
 
-  constexpr ct_vector(ct_vector&& other) noexcept : ct_vector() {
-    // Transfer ownership.
-    if (other.hold_external()) {
+  constexpr ct_vector(ct_vector&& other) noexcept : ct_vector{std::move(other), other.alloc_} {}
+
+  // Only non-throwing if the external storage of other can always be adopted. Otherwise, it may be copied.
+  constexpr ct_vector(ct_vector&& other, const Allocator& alloc) noexcept(alloc_traits::is_always_equal::value)
+      : ct_vector{alloc} {
+    // Transfer ownership. The external storage of other cannot be adopted if it belongs to another allocator.
+    if (other.hold_external() && alloc_ == other.alloc_) {
       data_ = other.data_;
       capacity_ = other.capacity_;
+      size_ = other.size_;
+      other.data_ = other.storage_.data();
+      other.capacity_ = StorageSize;
     } else {
+      reserve(other.size_);
       copy_n(other.data_, other.size_, data_);
     }
-    size_ = other.size_;
 
     // Reset other.
-    other.data_ = other.storage_.data();
     other.size_ = 0;
-    other.capacity_ = StorageSize;
   }
 
   constexpr ct_vector& operator=(const ct_vector& other) {
     if (&other == this) {
       return *this;
     }
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+      if (alloc_ != other.alloc_) {
+        free_external();
+      }
+      alloc_ = other.alloc_;
+    }
     reserve(other.size_);
     copy_n(other.data_, other.size_, data_);
     return *this;
   }
 
-  constexpr ct_vector& operator=(ct_vector&& other) noexcept {
+  constexpr ct_vector& operator=(ct_vector&& other) noexcept(
+      alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value) {
     if (&other == this) {
       return *this;
     }
+    if constexpr (!alloc_traits::propagate_on_container_move_assignment::value) {
+      // The external storage of other cannot be adopted if it belongs to another allocator.
+      if (alloc_ != other.alloc_) {
+        return *this = std::as_const(other);
+      }
+    }
 
     // Free this.
-    if (hold_external()) {
-      delete[] data_;  // NOLINT(cppcoreguidelines-owning-memory)
+    free_external();
+    if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+      alloc_ = other.alloc_;
     }
 
     // Transfer ownership.
@@ -87,7 +116,7 @@ class ct_vector {
 
   constexpr ~ct_vector() noexcept {
     if (hold_external()) {
-      delete[] data_;  // NOLINT(cppcoreguidelines-owning-memory)
+      alloc_traits::deallocate(alloc_, data_, capacity_);
     }
   }
 
@@ -99,18 +128,20 @@ class ct_vector {
 
     // Heavy pointer arithmetic because high level containers are not yet ready to use at constant evaluation.
     if (capacity_ < new_size) {
-      // NOLINTNEXTLINE(bugprone-unhandled-exception-at-new): char types cannot throw
-      Char* new_data = new Char[new_size];  // NOLINT(cppcoreguidelines-owning-memory)
-      copy_n(data_, size_, new_data);
+      Char* new_data = alloc_traits::allocate(alloc_, new_size);
       if (EMIO_Z_INTERNAL_IS_CONST_EVAL) {
-        // Required at compile-time because another reserve could happen without previous write to the data.
-        fill_n(new_data + size_, new_size - size_, 0);
+        // Required at compile-time to start the lifetime of the chars and because another reserve could happen
+        // without previous write to the data.
+        for (size_t i = 0; i < new_size; i++) {
+          std::construct_at(new_data + i, Char{});
+        }
       }
-      std::swap(new_data, data_);
-      capacity_ = new_size;
-      if (new_data != storage_.data()) {
-        delete[] new_data;  // NOLINT(cppcoreguidelines-owning-memory)
+      copy_n(data_, size_, new_data);
+      if (hold_external()) {
+        alloc_traits::deallocate(alloc_, data_, capacity_);
       }
+      data_ = new_data;
+      capacity_ = new_size;
     }
     size_ = new_size;
   }
@@ -135,15 +166,30 @@ class ct_vector {
     return data_;
   }
 
+  [[nodiscard]] constexpr Allocator get_allocator() const noexcept {
+    return alloc_;
+  }
+
  private:
   [[nodiscard]] constexpr bool hold_external() const noexcept {
     return data_ != storage_.data() && data_ != nullptr;
   }
 
+  // Frees the external storage and falls back to the inlined storage. The content is lost.
+  constexpr void free_external() noexcept {
+    if (hold_external()) {
+      alloc_traits::deallocate(alloc_, data_, capacity_);
+      data_ = storage_.data();
+      size_ = 0;
+      capacity_ = StorageSize;
+    }
+  }
+
   std::array<Char, StorageSize> storage_;
   Char* data_{storage_.data()};
   size_t size_{};
   size_t capacity_{StorageSize};
+  [[no_unique_address]] Allocator alloc_;
 };
 
 }  // namespace emio::detail
@@ -0,0 +1,469 @@
+//
+// Copyright (c) 2023 - present, Toni Neubert
+// All rights reserved.
+//
+// For the license information refer to emio.hpp
+
+// The conversion of a decimal number into the nearest floating-point value follows the structure of:
+// https://github.com/rust-lang/rust/tree/71ef9ecbdedb67c32f074884f503f8e582855c2f/library/core/src/num/dec2flt
+// The fast path is based on the Eisel-Lemire algorithm (https://arxiv.org/abs/2101.11408) but uses a compact table of
+// 128-bit powers of ten. The rounding decision is only accepted if the lower and the upper bound of the (slightly
+// imprecise) product round to the same value. Otherwise, a big integer comparison decides the correct rounding.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+#include "bignum.hpp"
+#include "predef.hpp"
+
+namespace emio::detail {
+
+/// The textual format of a floating-point number which should be parsed.
+enum class float_format : uint8_t {
+  general,     ///< Fixed or scientific notation.
+  fixed,       ///< Only fixed notation (no exponent).
+  scientific,  ///< Only scientific notation (exponent is required).
+};
+
+/// A parsed decimal number of the form: digits x 10^exponent.
+struct decimal_t {
+  /// The first (up to 19) significant digits.
+  uint64_t mantissa{};
+  /// The decimal exponent of the mantissa.
+  int64_t exponent{};
+  /// True if non-zero digits didn't fit into the mantissa.
+  bool truncated{};
+  /// All integral digits (may contain leading zeros).
+  std::string_view integral{};
+  /// All fractional digits (may contain trailing zeros).
+  std::string_view fraction{};
+  /// The decimal exponent of the complete digit sequence `integral` + `fraction`.
+  int64_t digits_exponent{};
+};
+
+inline constexpr size_t max_mantissa_digits = 19;
+
+/// Parses the decimal representation of a floating-point number without sign and without special values like "inf".
+/// On success, `it` points to the first not consumed char.
+/// @return False if the char sequence doesn't start with a valid number.
+inline constexpr bool parse_decimal(const char*& it, const char* const end, const float_format format,
+                                    decimal_t& dec) noexcept {
+  const auto is_digit = [](char c) noexcept {
+    return c >= '0' && c <= '9';
+  };
+
+  const char* p = it;
+  size_t significant_digits = 0;
+  const auto add_digit = [&](const char c) noexcept {
+    if (significant_digits < max_mantissa_digits) {
+      dec.mantissa = dec.mantissa * 10 + static_cast<uint64_t>(c - '0');
+      significant_digits += static_cast<size_t>(dec.mantissa != 0);
+      return true;
+    }
+    dec.truncated |= c != '0';
+    return false;
+  };
+
+  const char* const integral_begin = p;
+  while (p != end && is_digit(*p)) {
+    if (!add_digit(*p)) {
+      dec.exponent += 1;
+    }
+    ++p;
+  }
+  dec.integral = {integral_begin, p};
+
+  if (p != end && *p == '.') {
+    ++p;
+    const char* const fraction_begin = p;
+    while (p != end && is_digit(*p)) {
+      if (add_digit(*p)) {
+        dec.exponent -= 1;
+      }
+      ++p;
+    }
+    dec.fraction = {fraction_begin, p};
+  }
+  if (dec.integral.empty() && dec.fraction.empty()) {
+    return false;
+  }
+
+  int64_t explicit_exponent = 0;
+  if (format != float_format::fixed && p != end && (*p == 'e' || *p == 'E')) {
+    const char* exp_it = p + 1;
+    bool is_negative = false;
+    if (exp_it != end && (*exp_it == '+' || *exp_it == '-')) {
+      is_negative = *exp_it == '-';
+      ++exp_it;
+    }
+    if (exp_it != end && is_digit(*exp_it)) {
+      // Saturate the exponent. Such big numbers are zero or infinity anyway.
+      constexpr int64_t max_exponent = 0x10000000;
+      for (; exp_it != end && is_digit(*exp_it); ++exp_it) {
+        explicit_exponent = std::min(explicit_exponent * 10 + (*exp_it - '0'), max_exponent);
+      }
+      if (is_negative) {
+        explicit_exponent = -explicit_exponent;
+      }
+      p = exp_it;
+    } else if (format == float_format::scientific) {
+      return false;
+    }
+  } else if (format == float_format::scientific) {
+    return false;
+  }
+
+  dec.exponent += explicit_exponent;
+  dec.digits_exponent = explicit_exponent - static_cast<int64_t>(dec.fraction.size());
+  it = p;
+  return true;
+}
+
+/// Floating-point type properties required for the conversion.
+template <typename T>
+struct float_info;
+
+template <>
+struct float_info<float> {
+  using bits_t = uint32_t;
+  // Any mantissa (< 2^64) times 10^(smallest_pow10 - 1) rounds to zero.
+  static constexpr int64_t smallest_pow10 = -64;
+  // Any mantissa (>= 1) times 10^(largest_pow10 + 1) is infinity.
+  static constexpr int64_t largest_pow10 = 38;
+  // The largest power of ten which is exactly representable.
+  static constexpr int64_t max_exact_pow10 = 10;
+  // The number of significant digits required to decide the rounding.
+  static constexpr size_t max_digits = 114;
+};
+
+template <>
+struct float_info<double> {
+  using bits_t = uint64_t;
+  static constexpr int64_t smallest_pow10 = -342;
+  static constexpr int64_t largest_pow10 = 308;
+  static constexpr int64_t max_exact_pow10 = 22;
+  static constexpr size_t max_digits = 769;
+};
+
+// A simple 128-bit unsigned integer.
+struct uint128_t {
+  uint64_t hi;
+  uint64_t lo;
+
+  [[nodiscard]] constexpr int bit_width() const noexcept {
+    return static_cast<int>(hi != 0 ? 64 + std::bit_width(hi) : std::bit_width(lo));
+  }
+
+  [[nodiscard]] constexpr bool get_bit(int i) const noexcept {
+    return i >= 64 ? ((hi >> (i - 64)) & 1) != 0 : ((lo >> i) & 1) != 0;
+  }
+
+  // Returns true if any bit below bit `i` is set.
+  [[nodiscard]] constexpr bool any_below(int i) const noexcept {
+    if (i >= 64) {
+      return lo != 0 || (i > 64 && (hi << (128 - i)) != 0);
+    }
+    return i > 0 && (lo << (64 - i)) != 0;
+  }
+
+  // Returns the sum of the value and `v`. Overflows silently.
+  [[nodiscard]] constexpr uint128_t add(uint64_t v) const noexcept {
+    const uint64_t sum = lo + v;
+    return {hi + static_cast<uint64_t>(sum < lo), sum};
+  }
+
+  // Returns the value shifted right by `n` (n in [1, 127]) truncated to 64 bits.
+  [[nodiscard]] constexpr uint64_t shr(int n) const noexcept {
+    if (n >= 64) {
+      return hi >> (n - 64);
+    }
+    return (lo >> n) | (hi << (64 - n));
+  }
+};
+
+inline constexpr uint128_t umul128(uint64_t a, uint64_t b) noexcept {
+  constexpr uint64_t mask = 0xffffffff;
+  const uint64_t a_hi = a >> 32;
+  const uint64_t a_lo = a & mask;
+  const uint64_t b_hi = b >> 32;
+  const uint64_t b_lo = b & mask;
+  const uint64_t lo_lo = a_lo * b_lo;
+  const uint64_t hi_lo = a_hi * b_lo;
+  const uint64_t lo_hi = a_lo * b_hi;
+  const uint64_t hi_hi = a_hi * b_hi;
+  const uint64_t cross = (lo_lo >> 32) + (hi_lo & mask) + lo_hi;
+  return {hi_hi + (hi_lo >> 32) + (cross >> 32), (cross << 32) | (lo_lo & mask)};
+}
+
+// Returns the upper 128 bits of the 192-bit product of `a` and `b`.
+inline constexpr uint128_t umul192_upper128(uint64_t a, const uint128_t& b) noexcept {
+  const uint128_t hi = umul128(a, b.hi);
+  const uint128_t lo = umul128(a, b.lo);
+  const uint64_t mid = hi.lo + lo.hi;
+  return {hi.hi + static_cast<uint64_t>(mid < hi.lo), mid};
+}
+
+// A 128-bit power of ten with the most significant bit set, representing `f * 2^e`.
+struct pow10_128_t {
+  uint64_t hi;
+  uint64_t lo;
+  int16_t e;
+};
+
+inline constexpr int64_t pow10_128_step = 19;
+inline constexpr int64_t pow10_128_first = -342;
+
+// The following Python code generates this table (the values are rounded down):
+// for k in range(-342, 305, 19):
+//     if k >= 0: f = 10**k; e = 0
+//     else: e = -(128 - 4 * k + 10); f = (1 << -e) // 10**-k
+//     l = f.bit_length()
+//     f = f >> (l - 128) if l >= 128 else f << (128 - l); e += l - 128
+//     print('    {%#018x, %#018x, %5d},' % (f >> 64, f & (2**64 - 1), e))
+inline constexpr std::array<pow10_128_t, 35> pow10_128{{
+    {0xeef453d6923bd65a, 0x113faa2906a13b3f, -1264},  // 10^-342
+    {0x818995ce7aa0e1b2, 0x7343efebd1940993, -1200},  // 10^-323
+    {0x8c71dcd9ba0b4925, 0x9ff0c08b7f1d0b14, -1137},  // 10^-304
+    {0x9845418c345644d6, 0x830a13896b78aaa9, -1074},  // 10^-285
+    {0xa5178fff668ae0b6, 0x626e974dbe39a872, -1011},  // 10^-266
+    {0xb2fe3f0b8599ef07, 0x861fa7e6dcb4aa15, -948},   // 10^-247
+    {0xc21094364dfb5636, 0x985915fc12f542e4, -885},   // 10^-228
+    {0xd267caa862a12d66, 0xd072df63c324fd7b, -822},   // 10^-209
+    {0xe41f3d6a7377eeca, 0x20caba5f1d9e4a93, -759},   // 10^-190
+    {0xf7549530e188c128, 0xd12bee59e68ef47c, -696},   // 10^-171
+    {0x8613fd0145877585, 0xbd06742ce95f5f36, -632},   // 10^-152
+    {0x915e2486ef32cd60, 0x0ace1474dc1d122e, -569},   // 10^-133
+    {0x9d9ba7832936edc0, 0xd54b944b84aa4c0d, -506},   // 10^-114
+    {0xaae103b5fcd2a881, 0xd652bdc29f26a119, -443},   // 10^-95
+    {0xb94470938fa89bce, 0xf808e40e8d5b3e69, -380},   // 10^-76
+    {0xc8de047564d20a8b, 0xf245825a5a445275, -317},   // 10^-57
+    {0xd9c7dced53c72255, 0x96e7bd358c904a21, -254},   // 10^-38
+    {0xec1e4a7db69561a5, 0x2b31e9e3d06c32e5, -191},   // 10^-19
+    {0x8000000000000000, 0x0000000000000000, -127},   // 10^0
+    {0x8ac7230489e80000, 0x0000000000000000, -64},    // 10^19
+    {0x96769950b50d88f4, 0x1314448000000000, -1},     // 10^38
+    {0xa321f2d7226895c7, 0xaff72d52192b6a0d, 62},     // 10^57
+    {0xb0de65388cc8ada8, 0x3b25a55f43294bcb, 125},    // 10^76
+    {0xbfc2ef456ae276e8, 0x9e3fedd8c321a67e, 188},    // 10^95
+    {0xcfe87f7cef46ff16, 0xe612641865679a63, 251},    // 10^114
+    {0xe16a1dc9d8545e94, 0xf4296dd6fef3d67a, 314},    // 10^133
+    {0xf46518c2ef5b8cd1, 0x7eb258665fc25d69, 377},    // 10^152
+    {0x847c9b5d7c2e09b7, 0x69956135febada11, 441},    // 10^171
+    {0x8fa475791a569d10, 0xf96e017d694487bc, 504},    // 10^190
+    {0x9bbcc7a142b17ccb, 0x88a66076400bb691, 567},    // 10^209
+    {0xa8d9d1535ce3b396, 0x7f1839a741a14d0d, 630},    // 10^228
+    {0xb7118682dbb66a77, 0x3fbc8c33221dc2a1, 693},    // 10^247
+    {0xc67bb4597ce2ce48, 0xb143c6053edcd0d5, 756},    // 10^266
+    {0xd732290fbacaf133, 0xa97c177947ad4095, 819},    // 10^285
+    {0xe950df20247c83fd, 0x47c6b82ef32a2069, 882},    // 10^304
+}};
+
+// Returns an approximation of 10^k as 128-bit value `f * 2^e` with the most significant bit set.
+// The exact value lies within [f, f + 3) * 2^e.
+inline constexpr pow10_128_t get_pow10_128(int64_t k) noexcept {
+  const auto idx = static_cast<size_t>((k - pow10_128_first) / pow10_128_step);
+  const pow10_128_t& base = pow10_128[idx];
+  auto r = static_cast<int>(k - pow10_128_first) % pow10_128_step;
+  if (r == 0) {
+    return base;
+  }
+  uint64_t small = 10;
+  while (--r > 0) {
+    small *= 10;
+  }
+  // 192-bit product of base * 10^r, normalized and truncated to 128 bits.
+  const uint128_t hi = umul128(base.hi, small);
+  const uint128_t lo = umul128(base.lo, small);
+  const uint64_t mid = hi.lo + lo.hi;
+  const uint64_t top = hi.hi + static_cast<uint64_t>(mid < hi.lo);
+  const int shift = std::countl_zero(top);
+  const uint64_t res_hi = shift == 0 ? top : (top << shift) | (mid >> (64 - shift));
+  const uint64_t res_lo = shift == 0 ? mid : (mid << shift) | (lo.lo >> (64 - shift));
+  return {res_hi, res_lo, static_cast<int16_t>(base.e + 64 - shift)};
+}
+
+/// A floating-point value of the form: mantissa * 2^exp (with the exponent of the least significant bit).
+struct adjusted_fp_t {
+  uint64_t mantissa;
+  int32_t exp;
+
+  friend constexpr bool operator==(const adjusted_fp_t& lhs, const adjusted_fp_t& rhs) noexcept = default;
+};
+
+// The exponent of the least significant bit of the smallest subnormal value.
+template <typename T>
+inline constexpr int32_t min_lsb_exp = std::numeric_limits<T>::min_exponent - std::numeric_limits<T>::digits;
+
+// The exponent of the least significant bit of the largest finite value.
+template <typename T>
+inline constexpr int32_t max_lsb_exp = std::numeric_limits<T>::max_exponent - std::numeric_limits<T>::digits;
+
+// Rounds `x * 2^e` to the nearest representable value (ties to even).
+template <typename T>
+constexpr adjusted_fp_t round_to_float(const uint128_t& x, int32_t e) noexcept {
+  constexpr int digits = std::numeric_limits<T>::digits;
+  const int width = x.bit_width();
+  const int32_t lsb_exp = std::max(width - digits + e, min_lsb_exp<T>);
+  const int32_t shift = lsb_exp - e;
+  EMIO_Z_DEV_ASSERT(shift > 0);
+  if (shift > width) {
+    return {0, min_lsb_exp<T>};
+  }
+  adjusted_fp_t res{shift < 128 ? x.shr(shift) : 0, lsb_exp};
+  if (x.get_bit(shift - 1) && (x.any_below(shift - 1) || (res.mantissa & 1) != 0)) {
+    res.mantissa += 1;
+    if (res.mantissa == (uint64_t{1} << digits)) {
+      res.mantissa >>= 1;
+      res.exp += 1;
+    }
+  }
+  return res;
+}
+
+template <typename T>
+constexpr T make_float(const adjusted_fp_t& fp) noexcept {
+  using bits_t = typename float_info<T>::bits_t;
+  constexpr int mantissa_bits = std::numeric_limits<T>::digits - 1;
+  constexpr uint64_t hidden_bit = uint64_t{1} << mantissa_bits;
+
+  if (fp.exp > max_lsb_exp<T>) {
+    return std::numeric_limits<T>::infinity();
+  }
+  if (fp.mantissa < hidden_bit) {  // Subnormal or zero.
+    return std::bit_cast<T>(static_cast<bits_t>(fp.mantissa));
+  }
+  const auto biased_exp = static_cast<uint64_t>(fp.exp - min_lsb_exp<T> + 1);
+  return std::bit_cast<T>(static_cast<bits_t>((biased_exp << mantissa_bits) | (fp.mantissa & (hidden_bit - 1))));
+}
+
+// Returns the next representable value of `fp`.
+template <typename T>
+constexpr adjusted_fp_t next_float(adjusted_fp_t fp) noexcept {
+  fp.mantissa += 1;
+  if (fp.mantissa == (uint64_t{1} << std::numeric_limits<T>::digits)) {
+    fp.mantissa >>= 1;
+    fp.exp += 1;
+  }
+  return fp;
+}
+
+// Bignum big enough to hold the operands of the slow path comparison for double:
+// (2 * mantissa + 1) * 5^(342 + 769) < 2^2640.
+using dec2flt_bignum = basic_bignum<84>;
+
+// Decides if the exact value of the digits is below, equal or above the halfway point between `fp` and the next
+// representable value by using big integer arithmetic.
+template <typename T>
+constexpr adjusted_fp_t round_with_bignum(const decimal_t& dec, const adjusted_fp_t& fp) noexcept {
+  constexpr std::array<uint32_t, 10> pow10_u32{1,      10,      100,      1000,      10000,
+                                               100000, 1000000, 10000000, 100000000, 1000000000};
+
+  // Parse up to max_digits significant digits. If there are further non-zero digits, they are rounded up into the
+  // last digit which is enough to decide the rounding.
+  dec2flt_bignum digits{0U};
+  size_t num_digits = 0;
+  size_t skipped_digits = 0;
+  bool truncated = false;
+  uint32_t chunk = 0;
+  size_t chunk_size = 0;
+  const auto add_digits = [&](std::string_view str) noexcept {
+    for (const char c : str) {
+      if (num_digits == 0 && c == '0') {
+        continue;  // Leading zero.
+      }
+      if (num_digits == float_info<T>::max_digits) {
+        skipped_digits += 1;
+        truncated |= c != '0';
+        continue;
+      }
+      chunk = chunk * 10 + static_cast<uint32_t>(c - '0');
+      num_digits += 1;
+      if (++chunk_size == 9) {
+        digits.muladd_small(pow10_u32[9], chunk);
+        chunk = 0;
+        chunk_size = 0;
+      }
+    }
+  };
+  add_digits(dec.integral);
+  add_digits(dec.fraction);
+  if (chunk_size > 0) {
+    digits.muladd_small(pow10_u32[chunk_size], chunk);
+  }
+  if (truncated) {
+    digits.add_small(1);
+  }
+  const int64_t exp10 = dec.digits_exponent + static_cast<int64_t>(skipped_digits);
+
+  // Compare digits * 10^exp10 against the halfway point (2 * mantissa + 1) * 2^(exp - 1).
+  dec2flt_bignum halfway{2 * fp.mantissa + 1};
+  int64_t exp2 = exp10 - (fp.exp - 1);  // Power of two on the side of the digits.
+  if (exp10 >= 0) {
+    digits.mul_pow5(static_cast<size_t>(exp10));
+  } else {
+    halfway.mul_pow5(static_cast<size_t>(-exp10));
+  }
+  if (exp2 >= 0) {
+    digits.mul_pow2(static_cast<size_t>(exp2));
+  } else {
+    halfway.mul_pow2(static_cast<size_t>(-exp2));
+  }
+
+  const std::strong_ordering order = digits <=> halfway;
+  if (order > 0 || (order == 0 && (fp.mantissa & 1) != 0)) {
+    return next_float<T>(fp);
+  }
+  return fp;
+}
+
+/// Converts a parsed decimal number into the nearest floating-point value (ties to even).
+/// @return The absolute value. Infinity if the value is too big.
+template <typename T>
+constexpr T decimal_to_float(const decimal_t& dec) noexcept {
+  using info = float_info<T>;
+
+  if (dec.mantissa == 0 || dec.exponent < info::smallest_pow10) {
+    return T{0};
+  }
+  if (dec.exponent > info::largest_pow10) {
+    return std::numeric_limits<T>::infinity();
+  }
+
+  // Clinger's fast path: mantissa and power of ten are exact, therefore only one rounding happens.
+  constexpr uint64_t max_exact_mantissa = uint64_t{1} << std::numeric_limits<T>::digits;
+  if (!dec.truncated && dec.mantissa <= max_exact_mantissa && dec.exponent >= -info::max_exact_pow10 &&
+      dec.exponent <= info::max_exact_pow10) {
+    T pow10{1};
+    for (int64_t i = dec.exponent < 0 ? -dec.exponent : dec.exponent; i > 0; i--) {
+      pow10 *= 10;
+    }
+    const auto value = static_cast<T>(dec.mantissa);
+    return dec.exponent < 0 ? value / pow10 : value * pow10;
+  }
+
+  // Eisel-Lemire: the product of mantissa * 10^exponent is computed with 128 bits and lies within [lower, upper].
+  const pow10_128_t pow10 = get_pow10_128(dec.exponent);
+  const uint128_t lower = umul192_upper128(dec.mantissa, {pow10.hi, pow10.lo});
+  // The error is caused by the power of ten (< 3 * mantissa), the truncated low bits (< 1) and the truncated digits
+  // (< pow10 + 3).
+  uint128_t upper = lower.add(5);
+  if (dec.truncated) {
+    upper = upper.add(pow10.hi).add(2);
+  }
+  const int32_t e = pow10.e + 64;
+
+  const adjusted_fp_t fp = round_to_float<T>(lower, e);
+  if (upper.hi >= lower.hi && round_to_float<T>(upper, e) == fp) {
+    return make_float<T>(fp);
+  }
+  return make_float<T>(round_with_bignum<T>(dec, fp));
+}
+
+}  // namespace emio::detail
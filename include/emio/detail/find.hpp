@@ -0,0 +1,226 @@
+//
+// Copyright (c) 2021 - present, Toni Neubert
+// All rights reserved.
+//
+// For the license information refer to emio.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <string_view>
+
+#include "predef.hpp"
+
+#if !defined(EMIO_OPTIMIZE_FOR_SIZE)
+#  if defined(__AVX2__)
+#    include <immintrin.h>
+#    define EMIO_Z_INTERNAL_FIND_AVX2
+#  elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define EMIO_Z_INTERNAL_FIND_SSE2
+#  elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#    include <arm_neon.h>
+#    define EMIO_Z_INTERNAL_FIND_NEON
+#  endif
+#endif
+
+namespace emio::detail {
+
+// Searches the first char which is (Match = true) or isn't (Match = false) part of the group.
+template <bool Match>
+constexpr const char* find_group_scalar(const char* it, const char* const end, const std::string_view group) noexcept {
+  for (; it != end; ++it) {
+    if ((group.find(*it) != std::string_view::npos) == Match) {
+      return it;
+    }
+  }
+  return end;
+}
+
+#if !defined(EMIO_OPTIMIZE_FOR_SIZE)
+
+// Inputs shorter than this are searched scalar because setting up the table or the vector registers doesn't pay off.
+inline constexpr size_t min_find_group_vector_size{16};
+
+// Searches with a 256 entries lookup table. Used for larger groups and as fallback without SIMD instructions.
+template <bool Match>
+inline const char* find_group_table(const char* it, const char* const end, const std::string_view group) noexcept {
+  std::array<bool, 256> table{};
+  for (const char c : group) {
+    table[static_cast<uint8_t>(c)] = true;
+  }
+  for (; it != end; ++it) {
+    if (table[static_cast<uint8_t>(*it)] == Match) {
+      return it;
+    }
+  }
+  return end;
+}
+
+#  if defined(EMIO_Z_INTERNAL_FIND_AVX2) || defined(EMIO_Z_INTERNAL_FIND_SSE2) || defined(EMIO_Z_INTERNAL_FIND_NEON)
+
+// The maximum number of group chars compared at once by the SIMD kernels. Larger groups use the lookup table.
+inline constexpr size_t max_find_group_vector_chars{8};
+
+#    if defined(EMIO_Z_INTERNAL_FIND_AVX2)
+
+using find_vector_t = __m256i;
+inline constexpr size_t find_vector_size{32};
+
+inline find_vector_t find_broadcast(const char c) noexcept {
+  return _mm256_set1_epi8(c);
+}
+
+inline find_vector_t find_load(const char* ptr) noexcept {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));  // NOLINT: unaligned load
+}
+
+inline find_vector_t find_cmp_eq(const find_vector_t a, const find_vector_t b) noexcept {
+  return _mm256_cmpeq_epi8(a, b);
+}
+
+// Compares the chars as signed integers.
+inline find_vector_t find_cmp_lt(const find_vector_t a, const find_vector_t b) noexcept {
+  return _mm256_cmpgt_epi8(b, a);
+}
+
+inline find_vector_t find_or(const find_vector_t a, const find_vector_t b) noexcept {
+  return _mm256_or_si256(a, b);
+}
+
+// Returns a mask with find_mask_bits_per_char bits set for each matching char.
+inline uint64_t find_mask(const find_vector_t matches) noexcept {
+  return static_cast<uint32_t>(_mm256_movemask_epi8(matches));
+}
+
+inline constexpr uint64_t find_mask_all{0xFFFF'FFFF};
+inline constexpr int find_mask_bits_per_char{1};
+
+#    elif defined(EMIO_Z_INTERNAL_FIND_SSE2)
+
+using find_vector_t = __m128i;
+inline constexpr size_t find_vector_size{16};
+
+inline find_vector_t find_broadcast(const char c) noexcept {
+  return _mm_set1_epi8(c);
+}
+
+inline find_vector_t find_load(const char* ptr) noexcept {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));  // NOLINT: unaligned load
+}
+
+inline find_vector_t find_cmp_eq(const find_vector_t a, const find_vector_t b) noexcept {
+  return _mm_cmpeq_epi8(a, b);
+}
+
+inline find_vector_t find_cmp_lt(const find_vector_t a, const find_vector_t b) noexcept {
+  return _mm_cmplt_epi8(a, b);
+}
+
+inline find_vector_t find_or(const find_vector_t a, const find_vector_t b) noexcept {
+  return _mm_or_si128(a, b);
+}
+
+inline uint64_t find_mask(const find_vector_t matches) noexcept {
+  return static_cast<uint32_t>(_mm_movemask_epi8(matches));
+}
+
+inline constexpr uint64_t find_mask_all{0xFFFF};
+inline constexpr int find_mask_bits_per_char{1};
+
+#    elif defined(EMIO_Z_INTERNAL_FIND_NEON)
+
+using find_vector_t = uint8x16_t;
+inline constexpr size_t find_vector_size{16};
+
+inline find_vector_t find_broadcast(const char c) noexcept {
+  return vdupq_n_u8(static_cast<uint8_t>(c));
+}
+
+inline find_vector_t find_load(const char* ptr) noexcept {
+  return vld1q_u8(reinterpret_cast<const uint8_t*>(ptr));  // NOLINT: char to uint8_t
+}
+
+inline find_vector_t find_cmp_eq(const find_vector_t a, const find_vector_t b) noexcept {
+  return vceqq_u8(a, b);
+}
+
+inline find_vector_t find_cmp_lt(const find_vector_t a, const find_vector_t b) noexcept {
+  return vcltq_s8(vreinterpretq_s8_u8(a), vreinterpretq_s8_u8(b));
+}
+
+inline find_vector_t find_or(const find_vector_t a, const find_vector_t b) noexcept {
+  return vorrq_u8(a, b);
+}
+
+// NEON has no movemask. Narrowing each 16-bit lane by 4 bits results in 4 bits per char.
+inline uint64_t find_mask(const find_vector_t matches) noexcept {
+  return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matches), 4)), 0);
+}
+
+inline constexpr uint64_t find_mask_all{~uint64_t{0}};
+inline constexpr int find_mask_bits_per_char{4};
+
+#    endif
+
+// Compares a whole vector of input chars against each group char at once.
+template <bool Match>
+inline const char* find_group_vector(const char* it, const char* const end, const std::string_view group) noexcept {
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays): std::array drops vector attributes
+  find_vector_t needles[max_find_group_vector_chars];
+  const size_t needle_cnt = group.size();
+  for (size_t i = 0; i < needle_cnt; i++) {
+    needles[i] = find_broadcast(group[i]);
+  }
+
+  for (; static_cast<size_t>(end - it) >= find_vector_size; it += find_vector_size) {
+    const find_vector_t input = find_load(it);
+    find_vector_t matches = find_cmp_eq(input, needles[0]);
+    for (size_t i = 1; i < needle_cnt; i++) {
+      matches = find_or(matches, find_cmp_eq(input, needles[i]));
+    }
+    uint64_t mask = find_mask(matches);
+    if constexpr (!Match) {
+      mask ^= find_mask_all;
+    }
+    if (mask != 0) {
+      return it + std::countr_zero(mask) / find_mask_bits_per_char;
+    }
+  }
+  return find_group_scalar<Match>(it, end, group);
+}
+
+#  endif
+
+#endif
+
+/**
+ * Searches the first char which is (Match = true) or isn't (Match = false) part of the group.
+ * @param begin The begin of the input.
+ * @param end The end of the input.
+ * @param group The group of chars.
+ * @return The position of the found char or end.
+ */
+template <bool Match>
+constexpr const char* find_group(const char* const begin, const char* const end,
+                                 const std::string_view group) noexcept {
+#if defined(EMIO_OPTIMIZE_FOR_SIZE)
+  return find_group_scalar<Match>(begin, end, group);
+#else
+  if (EMIO_Z_INTERNAL_IS_CONST_EVAL || static_cast<size_t>(end - begin) < min_find_group_vector_size ||
+      group.empty()) {
+    return find_group_scalar<Match>(begin, end, group);
+  }
+#  if defined(EMIO_Z_INTERNAL_FIND_AVX2) || defined(EMIO_Z_INTERNAL_FIND_SSE2) || defined(EMIO_Z_INTERNAL_FIND_NEON)
+  if (group.size() <= max_find_group_vector_chars) {
+    return find_group_vector<Match>(begin, end, group);
+  }
+#  endif
+  return find_group_table<Match>(begin, end, group);
+#endif
+}
+
+}  // namespace emio::detail
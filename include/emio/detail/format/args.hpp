@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <cstring>
+
 #include "../../formatter.hpp"
 #include "../args.hpp"
 
@@ -28,7 +30,179 @@ struct format_arg_trait {
 
 using format_validation_arg = validation_arg<format_arg_trait>;
 
+/**
+ * Checks if an argument can be captured as raw bytes by serialize_arg_trait. These are all arguments which are unified
+ * to a core type (bools, chars, integers, floating-points, pointers and strings).
+ */
+template <typename Arg>
+inline constexpr bool is_serializable_v =
+    is_core_type_v<std::remove_cvref_t<unified_type_t<std::remove_const_t<Arg>>>> &&
+    !std::is_reference_v<unified_type_t<std::remove_const_t<Arg>>>;
+
+/**
+ * Serializes an argument into raw bytes and restores it from them, so that it can be formatted later.
+ * The argument is restored as its unified type. Strings are serialized with their size followed by their chars.
+ * @note The bytes are in the native representation and are only meant to be restored by the same program.
+ */
+template <typename Arg>
+  requires(is_serializable_v<Arg>)
+struct serialize_arg_trait {
+  using restored_type = std::remove_cvref_t<unified_type_t<std::remove_const_t<Arg>>>;
+
+  static constexpr size_t size(const Arg& arg) noexcept {
+    if constexpr (std::is_same_v<restored_type, std::string_view>) {
+      return sizeof(size_t) + restored_type{arg}.size();
+    } else {
+      return sizeof(restored_type);
+    }
+  }
+
+  static char* serialize(char* out, const Arg& arg) noexcept {
+    const restored_type value{arg};
+    if constexpr (std::is_same_v<restored_type, std::string_view>) {
+      const size_t size = value.size();
+      std::memcpy(out, &size, sizeof(size));
+      out += sizeof(size);
+      return detail::copy_n(value.data(), size, out);
+    } else {
+      std::memcpy(out, &value, sizeof(value));
+      return out + sizeof(value);
+    }
+  }
+
+  // The restored string references the chars inside of the serialized bytes.
+  static restored_type deserialize(const char*& in) noexcept {
+    if constexpr (std::is_same_v<restored_type, std::string_view>) {
+      size_t size{};
+      std::memcpy(&size, in, sizeof(size));
+      in += sizeof(size);
+      const restored_type value{in, size};
+      in += size;
+      return value;
+    } else {
+      restored_type value;
+      std::memcpy(&value, in, sizeof(value));
+      in += sizeof(value);
+      return value;
+    }
+  }
+};
+
+/**
+ * Type erased argument to format. Core types are stored in a tagged union and dispatched with a switch, which allows
+ * the compiler to inline their formatting. Only other types are dispatched through the virtual call of arg.
+ * @note The switch instantiates the formatters of all core types. Therefore, it is only used as format_arg if
+ * EMIO_ENABLE_TAGGED_FORMAT_ARGS is defined.
+ */
+class tagged_format_arg {
+ public:
+  template <typename T>
+  explicit tagged_format_arg(T& value) noexcept {
+    using unified_t = std::remove_cvref_t<unified_type_t<std::remove_const_t<T>>>;
+    if constexpr (std::is_same_v<unified_t, bool>) {
+      type_ = type::boolean;
+      bool_ = value;
+    } else if constexpr (std::is_same_v<unified_t, char>) {
+      type_ = type::character;
+      char_ = value;
+    } else if constexpr (std::is_same_v<unified_t, int32_t>) {
+      type_ = type::int32;
+      int32_ = value;
+    } else if constexpr (std::is_same_v<unified_t, uint32_t>) {
+      type_ = type::uint32;
+      uint32_ = value;
+    } else if constexpr (std::is_same_v<unified_t, int64_t>) {
+      type_ = type::int64;
+      int64_ = value;
+    } else if constexpr (std::is_same_v<unified_t, uint64_t>) {
+      type_ = type::uint64;
+      uint64_ = value;
+    } else if constexpr (std::is_same_v<unified_t, double>) {
+      type_ = type::floating_point;
+      double_ = static_cast<double>(value);
+    } else if constexpr (std::is_same_v<unified_t, std::string_view>) {
+      type_ = type::string;
+      std::construct_at(&str_, value);
+    } else if constexpr (std::is_null_pointer_v<unified_t>) {
+      type_ = type::null_pointer;
+    } else if constexpr (is_void_pointer_v<unified_t> && !std::is_volatile_v<std::remove_pointer_t<unified_t>>) {
+      type_ = type::pointer;
+      pointer_ = value;
+    } else {
+      type_ = type::custom;
+      std::construct_at(&custom_, value);
+    }
+  }
+
+  tagged_format_arg(const tagged_format_arg&) = delete;
+  tagged_format_arg(tagged_format_arg&&) = delete;
+  tagged_format_arg& operator=(const tagged_format_arg&) = delete;
+  tagged_format_arg& operator=(tagged_format_arg&&) = delete;
+  ~tagged_format_arg() = default;  // No destructor call to the custom arg because it holds only a reference.
+
+  result<void> process_arg(writer& out, reader& format_rdr) const noexcept {
+    switch (type_) {
+    case type::boolean:
+      return format_arg_trait<bool>::process_arg(out, format_rdr, bool_);
+    case type::character:
+      return format_arg_trait<char>::process_arg(out, format_rdr, char_);
+    case type::int32:
+      return format_arg_trait<int32_t>::process_arg(out, format_rdr, int32_);
+    case type::uint32:
+      return format_arg_trait<uint32_t>::process_arg(out, format_rdr, uint32_);
+    case type::int64:
+      return format_arg_trait<int64_t>::process_arg(out, format_rdr, int64_);
+    case type::uint64:
+      return format_arg_trait<uint64_t>::process_arg(out, format_rdr, uint64_);
+    case type::floating_point:
+      return format_arg_trait<double>::process_arg(out, format_rdr, double_);
+    case type::string:
+      return format_arg_trait<std::string_view>::process_arg(out, format_rdr, str_);
+    case type::null_pointer:
+      return format_arg_trait<std::nullptr_t>::process_arg(out, format_rdr, nullptr);
+    case type::pointer:
+      return format_arg_trait<const void*>::process_arg(out, format_rdr, pointer_);
+    case type::custom:
+      return custom_.process_arg(out, format_rdr);
+    }
+    EMIO_Z_INTERNAL_UNREACHABLE;
+  }
+
+ private:
+  enum class type : uint8_t {
+    boolean,
+    character,
+    int32,
+    uint32,
+    int64,
+    uint64,
+    floating_point,
+    string,
+    null_pointer,
+    pointer,
+    custom,
+  };
+
+  type type_;
+  union {
+    bool bool_;
+    char char_;
+    int32_t int32_;
+    uint32_t uint32_;
+    int64_t int64_;
+    uint64_t uint64_;
+    double double_;
+    std::string_view str_;
+    const void* pointer_;
+    arg<writer, format_arg_trait> custom_;
+  };
+};
+
+#if defined(EMIO_ENABLE_TAGGED_FORMAT_ARGS) && !defined(EMIO_OPTIMIZE_FOR_SIZE)
+using format_arg = tagged_format_arg;
+#else
 using format_arg = arg<writer, format_arg_trait>;
+#endif
 
 using format_args = args_span_with_str<format_arg>;
 
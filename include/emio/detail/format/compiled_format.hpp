@@ -0,0 +1,378 @@
+//
+// Copyright (c) 2021 - present, Toni Neubert
+// All rights reserved.
+//
+// For the license information refer to emio.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <exception>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+#include "format_to.hpp"
+
+namespace emio::detail::format {
+
+// A literal part of a format string. Escape sequences ("{{" and "}}") are kept as they are in the format string and
+// only collapsed during formatting to not require additional storage for each escaped segment.
+struct compiled_literal {
+  std::string_view str;
+  bool escaped{};
+};
+
+// The literal in front of a replacement field and the argument number of the replacement field. The format specs of
+// the first reference to an argument are parsed into its formatter. The specs of further references are kept as they
+// are in the format string (including the closing brace) and parsed when formatting.
+struct compiled_field {
+  compiled_literal prefix;
+  uint8_t arg_nbr{};
+  bool repeated{};
+  std::string_view specs;
+};
+
+inline constexpr result<void> write_compiled_literal(writer& out, const compiled_literal& literal) noexcept {
+  if (!literal.escaped) {
+    return out.write_literal(literal.str);
+  }
+  // Write each brace once and skip its duplicate.
+  const char* it = literal.str.data();
+  const char* const end = it + literal.str.size();
+  const char* begin = it;
+  while (it != end) {
+    const char c = *it++;
+    if (c == '{' || c == '}') {
+      EMIO_TRYV(out.write_literal(std::string_view{begin, it}));
+      if (it != end) {
+        ++it;
+      }
+      begin = it;
+    }
+  }
+  return out.write_literal(std::string_view{begin, it});
+}
+
+// Formats an argument with an already parsed formatter.
+template <typename Arg>
+constexpr result<void> format_with_parsed(writer& out, const formatter<Arg>& fmt, const Arg& arg) noexcept {
+  if constexpr (requires { fmt.format(out, arg); }) {
+    return fmt.format(out, arg);
+  } else {
+    // The formatter may change its state during formatting, therefore, a copy is used.
+    formatter<Arg> copy{fmt};
+    return copy.format(out, arg);
+  }
+}
+
+// Parses the already validated format specs of a repeated reference to an argument.
+template <typename Arg>
+constexpr formatter<Arg> parse_repeated_specs(const std::string_view specs) noexcept {
+  formatter<Arg> fmt{};
+  reader specs_rdr{specs};
+  fmt.parse(specs_rdr).value();
+  return fmt;
+}
+
+template <auto Str, typename... Args>
+class compiled_string_format;
+
+// Collects the literals and parses the format specs into the formatters while walking once over the format string.
+template <typename... Args>
+class format_compiler final : public parser<format_compiler<Args...>, input_validation::disabled> {
+ public:
+  constexpr explicit format_compiler(std::tuple<formatter<Args>...>& formatters, reader& format_rdr) noexcept
+      : parser<format_compiler<Args...>, input_validation::disabled>{format_rdr}, formatters_{formatters} {}
+
+  format_compiler(const format_compiler&) = delete;
+  format_compiler(format_compiler&&) = delete;
+  format_compiler& operator=(const format_compiler&) = delete;
+  format_compiler& operator=(format_compiler&&) = delete;
+  constexpr ~format_compiler() noexcept override;  // NOLINT(performance-trivially-destructible): See definition.
+
+  constexpr result<void> process(const std::string_view& str) noexcept override {
+    // The pieces of one literal are contiguous in the format string, only separated by the skipped duplicate brace of
+    // each escape sequence.
+    if (literal_.str.empty()) {
+      literal_.str = str;
+    } else {
+      literal_.str = std::string_view{literal_.str.data(), str.data() + str.size()};
+    }
+    const char last = str.back();
+    if (last == '{' || last == '}') {
+      literal_.escaped = true;
+    }
+    return success;
+  }
+
+  template <typename Arg>
+  constexpr result<void> process_arg(formatter<Arg>& fmt) noexcept {
+    const std::string_view remaining = this->format_rdr_.view_remaining();
+    if (repeated_) {
+      // The formatter of the first reference is kept. The specs are only skipped.
+      formatter<Arg> skipped{};
+      EMIO_TRYV(skipped.parse(this->format_rdr_));
+    } else {
+      EMIO_TRYV(fmt.parse(this->format_rdr_));
+    }
+    specs_ = remaining.substr(0, remaining.size() - this->format_rdr_.view_remaining().size());
+    return success;
+  }
+
+  constexpr result<std::string_view> parse_specs(uint8_t arg_nbr, bool repeated) noexcept {
+    repeated_ = repeated;
+    EMIO_TRYV(std::apply(
+        [&](formatter<Args>&... formatters) noexcept {
+          return this->apply(arg_nbr, formatters...);
+        },
+        formatters_));
+    return specs_;
+  }
+
+  constexpr compiled_literal take_literal() noexcept {
+    return std::exchange(literal_, compiled_literal{});
+  }
+
+ private:
+  std::tuple<formatter<Args>...>& formatters_;
+  compiled_literal literal_{};
+  bool repeated_{};
+  std::string_view specs_;
+};
+
+// Explicit out-of-class definition because of GCC bug: <destructor> used before its definition.
+template <typename... Args>
+constexpr format_compiler<Args...>::~format_compiler() noexcept = default;
+
+/**
+ * A format string which has been validated and split into literals and replacement fields with already parsed format
+ * specs. It can be reused to format arguments of the same types without walking over the format string again.
+ * @note The object refers to the format string which must outlive it. The format specs of an argument which is
+ * referenced more than once (e.g. "{0} {0:x}") are only parsed in advance for the first reference.
+ * @tparam MaxFields The maximum number of replacement fields.
+ * @tparam Args The argument types to format.
+ */
+template <size_t MaxFields, typename... Args>
+  requires(MaxFields >= sizeof...(Args))
+class basic_compiled_format {
+ public:
+  /**
+   * Validates and compiles a format string at runtime.
+   * @param s The format string.
+   * @return The compiled format string or invalid_format if the validation failed or out_of_range if the format string
+   * has more replacement fields than MaxFields.
+   */
+  template <typename S>
+    requires(std::is_constructible_v<std::string_view, S>)
+  static constexpr result<basic_compiled_format> from(const S& s) noexcept {
+    const std::string_view str{s};
+    if (!format_trait::validate_string<Args...>(str)) {
+      return err::invalid_format;
+    }
+
+    basic_compiled_format compiled;
+    reader format_rdr{str};
+    format_compiler<Args...> compiler{compiled.formatters_, format_rdr};
+    std::array<bool, sizeof...(Args)> referenced{};
+    while (true) {
+      uint8_t arg_nbr{detail::no_more_args};
+      EMIO_TRYV(compiler.parse(arg_nbr));
+      if (arg_nbr == detail::no_more_args) {
+        break;
+      }
+      if (compiled.field_cnt_ == MaxFields) {
+        return err::out_of_range;
+      }
+      compiled_field& field = compiled.fields_[compiled.field_cnt_++];
+      field.prefix = compiler.take_literal();
+      field.arg_nbr = arg_nbr;
+      field.repeated = std::exchange(referenced[arg_nbr], true);
+      EMIO_TRY(field.specs, compiler.parse_specs(arg_nbr, field.repeated));
+    }
+    compiled.suffix_ = compiler.take_literal();
+    return compiled;
+  }
+
+  /**
+   * Validates and compiles a runtime format string.
+   * @param s The runtime format string.
+   * @return The compiled format string or invalid_format if the validation failed or out_of_range if the format string
+   * has more replacement fields than MaxFields.
+   */
+  static constexpr result<basic_compiled_format> from(const runtime_string& s) noexcept {
+    return from(s.get());
+  }
+
+  /**
+   * Formats the arguments according to the compiled format string.
+   * @param out The output writer.
+   * @param args The arguments to be formatted.
+   * @return Success or EOF if the buffer is to small or an error of the formatter of an argument.
+   */
+  constexpr result<void> format(writer& out, const Args&... args) const noexcept {
+    const std::tuple<const Args&...> arg_refs{args...};
+    for (size_t i = 0; i < field_cnt_; i++) {
+      const compiled_field& field = fields_[i];
+      EMIO_TRYV(write_compiled_literal(out, field.prefix));
+      EMIO_TRYV(format_arg(out, field, arg_refs));
+    }
+    return write_compiled_literal(out, suffix_);
+  }
+
+  /**
+   * Returns the number of replacement fields.
+   * @return The number of replacement fields.
+   */
+  [[nodiscard]] constexpr size_t field_count() const noexcept {
+    return field_cnt_;
+  }
+
+ private:
+  constexpr basic_compiled_format() noexcept = default;
+
+  template <size_t I = 0>
+  constexpr result<void> format_arg(writer& out, const compiled_field& field,
+                                    const std::tuple<const Args&...>& args) const noexcept {
+    if constexpr (I < sizeof...(Args)) {
+      if (field.arg_nbr == I) {
+        using arg_t = std::tuple_element_t<I, std::tuple<Args...>>;
+        if (field.repeated) {
+          return format_with_parsed(out, parse_repeated_specs<arg_t>(field.specs), std::get<I>(args));
+        }
+        return format_with_parsed(out, std::get<I>(formatters_), std::get<I>(args));
+      }
+      return format_arg<I + 1>(out, field, args);
+    } else {
+      EMIO_Z_DEV_ASSERT(false);
+      EMIO_Z_INTERNAL_UNREACHABLE;
+    }
+  }
+
+  template <auto Str, typename... Ts>
+  friend class compiled_string_format;
+
+  std::array<compiled_field, MaxFields> fields_{};
+  size_t field_cnt_{};
+  compiled_literal suffix_{};
+  std::tuple<formatter<Args>...> formatters_{};
+};
+
+/**
+ * A string literal which can be used as non-type template parameter.
+ * @tparam N The size of the string literal including the null terminator.
+ */
+template <size_t N>
+struct fixed_string {
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays): construction from a string literal
+  consteval fixed_string(const char (&str)[N]) noexcept {
+    for (size_t i = 0; i < N; i++) {
+      data[i] = str[i];
+    }
+  }
+
+  [[nodiscard]] constexpr std::string_view view() const noexcept {
+    return {data, N - 1};
+  }
+
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays): must be public to be structural
+  char data[N]{};
+};
+
+// Tag type to select the compile-time compiled format functions.
+template <fixed_string Str>
+struct compiled_string {};
+
+// Formats the arguments with a format string compiled at compile-time. Each literal is written directly and each
+// replacement field calls the formatter of its argument with the format specs parsed at compile-time.
+template <auto Str, typename... Args>
+class compiled_string_format {
+ public:
+  static constexpr result<void> format(writer& out, const Args&... args) noexcept {
+    const std::tuple<const Args&...> arg_refs{args...};
+    EMIO_TRYV(format_fields(out, arg_refs, std::make_index_sequence<field_cnt>{}));
+    constexpr compiled_literal suffix = compiled_.suffix_;
+    if constexpr (!suffix.str.empty()) {
+      return write_compiled_literal(out, suffix);
+    }
+    return success;
+  }
+
+  static constexpr size_t max_formatted_size() noexcept {
+    return max_fields_size(std::make_index_sequence<field_cnt>{}) + literal_size(compiled_.suffix_);
+  }
+
+ private:
+  // Each replacement field needs at least two chars. Therefore, this is an upper bound to count the fields.
+  static constexpr size_t max_field_cnt = std::max(Str.view().size() / 2, sizeof...(Args));
+
+  template <size_t MaxFields>
+  static constexpr basic_compiled_format<MaxFields, Args...> compile() noexcept {
+    result<basic_compiled_format<MaxFields, Args...>> compiled =
+        basic_compiled_format<MaxFields, Args...>::from(Str.view());
+    if (!compiled) {
+      std::terminate();  // Invalid format string.
+    }
+    return *compiled;
+  }
+
+  static constexpr size_t field_cnt = compile<max_field_cnt>().field_count();
+  static constexpr basic_compiled_format<field_cnt, Args...> compiled_ = compile<field_cnt>();
+
+  // The formatter of a field with its format specs parsed at compile-time.
+  template <size_t Field>
+  static constexpr auto field_formatter() noexcept {
+    constexpr compiled_field field = compiled_.fields_[Field];
+    if constexpr (field.repeated) {
+      return parse_repeated_specs<std::tuple_element_t<field.arg_nbr, std::tuple<Args...>>>(field.specs);
+    } else {
+      return std::get<field.arg_nbr>(compiled_.formatters_);
+    }
+  }
+
+  template <size_t Field>
+  static constexpr auto field_formatter_v = field_formatter<Field>();
+
+  template <size_t... Fields>
+  static constexpr result<void> format_fields(writer& out, const std::tuple<const Args&...>& args,
+                                              std::index_sequence<Fields...> /*unused*/) noexcept {
+    result<void> res = success;
+    static_cast<void>(((res = format_field<Fields>(out, args)).has_value() && ...));
+    return res;
+  }
+
+  static constexpr size_t literal_size(const compiled_literal& literal) noexcept {
+    counting_buffer buf{};
+    writer wtr{buf};
+    write_compiled_literal(wtr, literal).value();
+    return buf.count();
+  }
+
+  template <size_t... Fields>
+  static constexpr size_t max_fields_size(std::index_sequence<Fields...> /*unused*/) noexcept {
+    return (size_t{} + ... + max_field_size<Fields>());
+  }
+
+  template <size_t Field>
+  static constexpr size_t max_field_size() noexcept {
+    constexpr compiled_field field = compiled_.fields_[Field];
+    constexpr const auto& fmt = field_formatter_v<Field>;
+    static_assert(requires { fmt.max_formatted_size(); },
+                  "The formatter of an argument doesn't provide the maximum output size.");
+    constexpr std::optional<size_t> size = fmt.max_formatted_size();
+    static_assert(size.has_value(), "The output size of an argument isn't bounded (e.g. a string without precision).");
+    return literal_size(field.prefix) + *size;
+  }
+
+  template <size_t Field>
+  static constexpr result<void> format_field(writer& out, const std::tuple<const Args&...>& args) noexcept {
+    constexpr compiled_field field = compiled_.fields_[Field];
+    if constexpr (!field.prefix.str.empty()) {
+      EMIO_TRYV(write_compiled_literal(out, field.prefix));
+    }
+    return format_with_parsed(out, field_formatter_v<Field>, std::get<field.arg_nbr>(args));
+  }
+};
+
+}  // namespace emio::detail::format
@@ -204,7 +204,7 @@ inline constexpr format_fp_result_t format_exact(const finite_result_t& dec, emi
   return {dst.subspan(0, len), k};
 }
 
-inline constexpr format_fp_result_t format_shortest(const finite_result_t& dec, emio::buffer& buf) noexcept {
+inline constexpr format_fp_result_t format_shortest(const finite_result_t& dec, std::span<char> dst) noexcept {
   // the number `v` to format is known to be:
   // - equal to `mant * 2^exp`;
   // - preceded by `(mant - 2 * minus) * 2^exp` in the original type; and
@@ -219,7 +219,7 @@ inline constexpr format_fp_result_t format_shortest(const finite_result_t& dec,
   EMIO_Z_DEV_ASSERT(dec.mant > 0);
   EMIO_Z_DEV_ASSERT(dec.minus > 0);
   EMIO_Z_DEV_ASSERT(dec.plus > 0);
-  //  EMIO_Z_DEV_ASSERT(buf.() >= MAX_SIG_DIGITS);
+  EMIO_Z_DEV_ASSERT(dst.size() >= std::numeric_limits<double>::max_digits10);
 
   // `a.cmp(&b) < rounding` is `if d.inclusive {a <= b} else {a < b}`
   const auto rounding = [&](std::strong_ordering ordering) noexcept {
@@ -295,8 +295,6 @@ inline constexpr format_fp_result_t format_shortest(const finite_result_t& dec,
   bignum scale8 = scale;
   scale8.mul_pow2(3);
 
-  auto dst = buf.get_write_area_of(std::numeric_limits<double>::max_digits10).value();
-
   bool down{};
   bool up{};
   size_t i{};
@@ -394,4 +392,8 @@ inline constexpr format_fp_result_t format_shortest(const finite_result_t& dec,
   return {dst.subspan(0, i), k};
 }
 
+inline constexpr format_fp_result_t format_shortest(const finite_result_t& dec, emio::buffer& buf) noexcept {
+  return format_shortest(dec, buf.get_write_area_of(std::numeric_limits<double>::max_digits10).value());
+}
+
 }  // namespace emio::detail::format
@@ -40,7 +40,7 @@ inline result<void> vformat_to(buffer& buf, const format_args& args) noexcept {
   EMIO_TRY(const std::string_view str, args.get_str());
   writer wtr{buf};
   if (args.is_plain_str()) {
-    return wtr.write_str(str);
+    return wtr.write_literal(str);
   }
   return parse<format_parser>(str, wtr, related_format_args{args});
 }
@@ -52,7 +52,7 @@ constexpr result<void> format_to(buffer& buf, const format_string<Args...>& form
   EMIO_TRY(const std::string_view str, format_string.get());
   writer wtr{buf};
   if (format_string.is_plain_str()) {
-    return wtr.write_str(str);
+    return wtr.write_literal(str);
   }
   return parse<format_parser>(str, wtr, args...);
 }
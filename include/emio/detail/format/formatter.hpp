@@ -6,10 +6,13 @@
 
 #pragma once
 
+#include <optional>
+
 #include "../../reader.hpp"
 #include "../../writer.hpp"
 #include "../misc.hpp"
 #include "dragon.hpp"
+#include "grisu.hpp"
 #include "specs.hpp"
 
 namespace emio {
@@ -210,7 +213,7 @@ inline constexpr fp_format_specs parse_fp_format_specs(const format_specs& specs
       .precision =
           specs.precision >= 0 || specs.type == no_type ? static_cast<int16_t>(specs.precision) : default_precision,
       .format = fp_format::general,
-      .upper_case = specs.type == 'E' || specs.type == 'F' || specs.type == 'G',
+      .upper_case = specs.type == 'E' || specs.type == 'F' || specs.type == 'G' || specs.type == 'A',
       .showpoint = specs.alternate_form,
   };
 
@@ -223,6 +226,8 @@ inline constexpr fp_format_specs parse_fp_format_specs(const format_specs& specs
     fp_specs.showpoint |= specs.precision != 0;
   } else if (specs.type == 'a' || specs.type == 'A') {
     fp_specs.format = fp_format::hex;
+    fp_specs.precision = static_cast<int16_t>(specs.precision);  // Exact representation if no precision is given.
+    return fp_specs;
   }
   if (fp_specs.format != fp_format::fixed && fp_specs.precision == 0) {
     fp_specs.precision = 1;  // Calculate at least on significand.
@@ -259,6 +264,91 @@ inline constexpr char* write_exponent(char* it, int exp) noexcept {
   return it;
 }
 
+inline constexpr result<void> write_hex(writer& out, format_specs& specs, const fp_format_specs& fp_specs,
+                                        const decode_result_t& decoded) noexcept {
+  using namespace alternate_form;
+
+  constexpr int significand_bits = std::numeric_limits<double>::digits - 1;
+  constexpr int max_xdigits = significand_bits / 4;
+  constexpr uint64_t fraction_mask = (uint64_t{1} << significand_bits) - 1;
+
+  // Restore the significand (with the implicit leading bit) and the binary exponent of 1.xxx * 2^exp.
+  uint64_t significand = 0;
+  int exp = 0;
+  if (decoded.category == category::finite) {
+    const finite_result_t& finite = decoded.finite;
+    const int shift = static_cast<int>(std::bit_width(finite.mant)) - (significand_bits + 1);
+    exp = finite.exp + shift + significand_bits;
+    if (exp >= std::numeric_limits<double>::min_exponent - 1) {
+      significand = finite.mant >> shift;
+    } else {  // Subnormal: 0.xxx * 2^-1022.
+      significand = finite.mant >> (std::numeric_limits<double>::min_exponent - 1 - significand_bits - finite.exp);
+      exp = std::numeric_limits<double>::min_exponent - 1;
+    }
+  }
+
+  // Round to the requested precision (ties to even) or remove trailing zeros.
+  const int precision = fp_specs.precision;
+  int num_xdigits = max_xdigits;
+  if (precision >= 0 && precision < max_xdigits) {
+    const int shift = (max_xdigits - precision) * 4;
+    const uint64_t half = uint64_t{1} << (shift - 1);
+    const uint64_t remainder = significand & ((uint64_t{1} << shift) - 1);
+    significand >>= shift;
+    if (remainder > half || (remainder == half && (significand & 1) != 0)) {
+      significand += 1;  // A carry into the leading digit is fine (e.g. 0x1.f -> 0x2).
+    }
+    significand <<= shift;
+    num_xdigits = precision;
+  } else if (precision < 0) {
+    const uint64_t fraction = significand & fraction_mask;
+    num_xdigits = fraction == 0 ? 0 : max_xdigits - std::countr_zero(fraction) / 4;
+  }
+  const int num_zeros = precision > max_xdigits ? precision - max_xdigits : 0;
+  const bool write_point = num_xdigits > 0 || num_zeros > 0 || specs.alternate_form;
+
+  const uint32_t abs_exp = static_cast<uint32_t>(exp >= 0 ? exp : -exp);
+  const size_t exp_digits = get_number_of_digits(abs_exp, 10);
+
+  const std::string_view prefix = fp_specs.upper_case ? hex_upper : hex_lower;
+  const bool has_sign = decoded.negative || specs.sign == ' ' || specs.sign == '+';
+
+  // Leading digit, point, fraction digits, trailing zeros, 'p' and the exponent.
+  const size_t num_digits = 1 + static_cast<size_t>(write_point) + static_cast<size_t>(num_xdigits + num_zeros) +
+                            2 /* p + sign */ + exp_digits;
+  const size_t total_width = static_cast<size_t>(has_sign) + prefix.size() + num_digits;
+
+  EMIO_TRY(const char sign_to_write, try_write_sign(out, specs, decoded.negative));
+  std::string_view prefix_to_write = prefix;
+  if (specs.zero_flag) {  // Zeros are placed between the prefix and the digits.
+    EMIO_TRYV(out.write_str(prefix));
+    prefix_to_write = ""sv;
+  }
+
+  return write_padded<alignment::right>(out, specs, total_width, [&]() noexcept -> result<void> {
+    const size_t area_size = num_digits + static_cast<size_t>(sign_to_write != no_sign) + prefix_to_write.size();
+    EMIO_TRY(auto area, out.get_buffer().get_write_area_of(area_size));
+    auto* it = area.data();
+    if (sign_to_write != no_sign) {
+      *it++ = sign_to_write;
+    }
+    it = copy_n(prefix_to_write.data(), prefix_to_write.size(), it);
+    *it++ = digit_to_char(static_cast<int>(significand >> significand_bits), fp_specs.upper_case);
+    if (write_point) {
+      *it++ = '.';
+    }
+    for (int i = 1; i <= num_xdigits; i++) {
+      const auto xdigit = static_cast<int>((significand >> (significand_bits - i * 4)) & 0xF);
+      *it++ = digit_to_char(xdigit, fp_specs.upper_case);
+    }
+    it = fill_n(it, num_zeros, '0');
+    *it++ = fp_specs.upper_case ? 'P' : 'p';
+    *it++ = exp < 0 ? '-' : '+';
+    write_decimal(abs_exp, it + exp_digits);
+    return success;
+  });
+}
+
 inline constexpr result<void> write_decimal(writer& out, format_specs& specs, fp_format_specs& fp_specs,
                                             bool is_negative, const format_fp_result_t& f) noexcept {
   const char* significand = f.digits.data();
@@ -412,6 +502,21 @@ inline constexpr result<void> write_decimal(writer& out, format_specs& specs, fp
 
 inline constexpr std::array<char, 1> zero_digit{'0'};
 
+inline constexpr format_fp_result_t format_exact_decimal(buffer& buffer, const finite_result_t& finite,
+                                                         format_exact_mode mode, int16_t number_of_digits) noexcept {
+#if !defined(EMIO_OPTIMIZE_FOR_SIZE)
+  // Grisu is much faster but limited in the number of digits and can't prove the correctness for a few values. Dragon4
+  // is the fallback for them.
+  std::array<char, grisu_exact_max_digits> digits{};
+  if (const std::optional<format_fp_result_t> res = format_exact_opt(finite, digits, mode, number_of_digits)) {
+    const std::span<char> dst = buffer.get_write_area_of(res->digits.size()).value();
+    copy_n(res->digits.data(), res->digits.size(), dst.data());
+    return format_fp_result_t{dst, res->exp};
+  }
+#endif
+  return format_exact(finite, buffer, mode, number_of_digits);
+}
+
 inline constexpr format_fp_result_t format_decimal(buffer& buffer, const fp_format_specs& fp_specs,
                                                    const decode_result_t& decoded) noexcept {
   if (decoded.category == category::zero) {
@@ -420,24 +525,75 @@ inline constexpr format_fp_result_t format_decimal(buffer& buffer, const fp_form
   switch (fp_specs.format) {
   case fp_format::general:
     if (fp_specs.precision == no_precision) {
-      return format_shortest(decoded.finite, buffer);
+      const std::span<char> dst = buffer.get_write_area_of(std::numeric_limits<double>::max_digits10).value();
+#if !defined(EMIO_OPTIMIZE_FOR_SIZE)
+      // Grisu is much faster but can't prove the correctness for a few values. Dragon4 is the fallback for them.
+      if (const std::optional<format_fp_result_t> res = format_shortest_opt(decoded.finite, dst)) {
+        return *res;
+      }
+#endif
+      return format_shortest(decoded.finite, dst);
     }
     [[fallthrough]];
   case fp_format::exp:
-    return format_exact(decoded.finite, buffer, format_exact_mode::significand_digits, fp_specs.precision);
+    return format_exact_decimal(buffer, decoded.finite, format_exact_mode::significand_digits, fp_specs.precision);
   case fp_format::fixed: {
-    auto res = format_exact(decoded.finite, buffer, format_exact_mode::decimal_point, fp_specs.precision);
+    auto res = format_exact_decimal(buffer, decoded.finite, format_exact_mode::decimal_point, fp_specs.precision);
     if (res.digits.empty()) {
       return format_fp_result_t{zero_digit, 1};
     }
     return res;
   }
   case fp_format::hex:
-    std::terminate();
+    break;  // Written by write_hex.
+  }
+  EMIO_Z_INTERNAL_UNREACHABLE;
+}
+
+inline constexpr int16_t max_fp_precision = 1100;
+
+// Dragon4 can't generate more integral digits than its bignum can hold (log10(2) ~ 30103 / 100000).
+inline constexpr size_t max_fp_integral_digits = bignum::max_blocks * 32 * 30103 / 100000 + 1;
+
+// The digit workspace is large enough for the maximal precision plus one extra digit due to rounding.
+inline constexpr size_t max_fp_digits = max_fp_integral_digits + max_fp_precision + 1;
+
+// The digit workspace used for the shortest representation and small precisions.
+inline constexpr size_t small_fp_digits = 64;
+
+// Returns an upper bound of the number of digits `format_decimal` writes into its buffer.
+inline constexpr size_t estimate_number_of_digits(const fp_format_specs& fp_specs,
+                                                  const decode_result_t& decoded) noexcept {
+  if (decoded.category != category::finite) {
+    return 0;
+  }
+  switch (fp_specs.format) {
+  case fp_format::general:
+    if (fp_specs.precision == no_precision) {
+      return std::numeric_limits<double>::max_digits10;
+    }
+    [[fallthrough]];
+  case fp_format::exp:
+    return static_cast<size_t>(fp_specs.precision) + 1;
+  case fp_format::fixed: {
+    // The estimation of `k` is at most one too small. Rounding can add one more digit.
+    const int k = estimate_scaling_factor(decoded.finite.mant, decoded.finite.exp) + 1;
+    return static_cast<size_t>(std::max(k + fp_specs.precision, 0)) + 1;
+  }
+  case fp_format::hex:
+    return 0;
   }
   EMIO_Z_INTERNAL_UNREACHABLE;
 }
 
+template <size_t WorkspaceSize>
+constexpr result<void> format_and_write_decimal(writer& out, format_specs& specs, fp_format_specs& fp_specs,
+                                                const decode_result_t& decoded) noexcept {
+  emio::static_buffer<WorkspaceSize> workspace;
+  const format_fp_result_t res = format_decimal(workspace, fp_specs, decoded);
+  return write_decimal(out, specs, fp_specs, decoded.negative, res);
+}
+
 inline constexpr result<void> format_and_write_decimal(writer& out, format_specs& specs,
                                                        const decode_result_t& decoded) noexcept {
   fp_format_specs fp_specs = parse_fp_format_specs(specs);
@@ -458,9 +614,15 @@ inline constexpr result<void> format_and_write_decimal(writer& out, format_specs
     });
   }
 
-  emio::memory_buffer buf;
-  const format_fp_result_t res = format_decimal(buf, fp_specs, decoded);
-  return write_decimal(out, specs, fp_specs, decoded.negative, res);
+  if (fp_specs.format == fp_format::hex) {
+    return write_hex(out, specs, fp_specs, decoded);
+  }
+
+  // The digits are generated into a stack-resident workspace, sized by the requested precision.
+  if (estimate_number_of_digits(fp_specs, decoded) <= small_fp_digits) {
+    return format_and_write_decimal<small_fp_digits>(out, specs, fp_specs, decoded);
+  }
+  return format_and_write_decimal<max_fp_digits>(out, specs, fp_specs, decoded);
 }
 
 template <typename Arg>
@@ -478,6 +640,10 @@ inline constexpr result<void> write_arg(writer& out, format_specs& specs, std::s
       return out.write_str(arg);
     });
   }
+  // The escaped size is only needed for the padding.
+  if (specs.width == 0) {
+    return detail::write_str_escaped(out.get_buffer(), arg, '"');
+  }
   const size_t escaped_size = detail::count_size_when_escaped(arg);
   return write_padded<alignment::left>(out, specs, escaped_size + 2U /* quotes */, [&]() noexcept {
     return detail::write_str_escaped(out.get_buffer(), arg, escaped_size, '"');
@@ -534,6 +700,107 @@ constexpr result<void> write_arg(writer& out, format_specs& specs, Arg arg) noex
   });
 }
 
+//
+// Maximum output size.
+//
+
+// Upper bound of the number of characters write_arg produces for any value of an integral type.
+template <typename Arg>
+constexpr size_t max_integral_size(const format_specs& specs) noexcept {
+  if (specs.type == 'c') {
+    return 1;
+  }
+  constexpr size_t bits = std::numeric_limits<std::make_unsigned_t<Arg>>::digits;
+  size_t size = 0;
+  switch (specs.type) {
+  case 'b':
+  case 'B':
+    size = bits + (specs.alternate_form ? 2 : 0);
+    break;
+  case 'o':
+    size = (bits + 2) / 3 + (specs.alternate_form ? 1 : 0);
+    break;
+  case 'x':
+  case 'X':
+    size = (bits + 3) / 4 + (specs.alternate_form ? 2 : 0);
+    break;
+  default:
+    size = std::numeric_limits<Arg>::digits10 + 1;
+    break;
+  }
+  if (std::is_signed_v<Arg> || specs.sign == '+' || specs.sign == ' ') {
+    size += 1;
+  }
+  return size;
+}
+
+// Upper bound of the number of characters write_arg produces for any floating-point value.
+inline constexpr size_t max_floating_point_size(const format_specs& specs) noexcept {
+  constexpr size_t max_exp_digits = 3;  // e+308
+  const fp_format_specs fp_specs = parse_fp_format_specs(specs);
+  const auto precision = static_cast<size_t>(fp_specs.precision);
+  size_t size = 1;  // Sign.
+  switch (fp_specs.format) {
+  case fp_format::hex: {
+    constexpr size_t max_xdigits = (std::numeric_limits<double>::digits - 1 + 3) / 4;
+    constexpr size_t max_bin_exp_digits = 4;  // p-1022
+    size += 2 /* 0x */ + 1 + 1 /* . */ + (fp_specs.precision < 0 ? max_xdigits : precision) + 2 + max_bin_exp_digits;
+    break;
+  }
+  case fp_format::exp:
+    size += precision + 1 /* . */ + 2 /* e+ */ + max_exp_digits;
+    break;
+  case fp_format::fixed:
+    size += std::numeric_limits<double>::max_exponent10 + 1 + 1 /* . */ + precision;
+    break;
+  case fp_format::general: {
+    // Either the exponent notation or the fixed notation with at most four leading zeros (0.000ddd). The shortest
+    // representation has at most max_digits10 significand digits.
+    const size_t digits = fp_specs.precision < 0 ? std::numeric_limits<double>::max_digits10 : precision;
+    size += digits + 1 /* . */ + std::max<size_t>(2 + max_exp_digits, 4);
+    break;
+  }
+  }
+  return size;
+}
+
+// Returns an upper bound of the number of characters write_arg produces for any value of type Arg with the given
+// format specs or nullopt if the output size isn't bounded.
+template <typename Arg>
+constexpr std::optional<size_t> max_formatted_size(const format_specs& specs) noexcept {
+  size_t size = 0;
+  if constexpr (std::is_same_v<Arg, bool>) {
+    size = specs.type == no_type || specs.type == 's' ? 5 : max_integral_size<uint8_t>(specs);
+  } else if constexpr (std::is_same_v<Arg, char>) {
+    if (specs.type == no_type || specs.type == 'c') {
+      size = 1;
+    } else if (specs.type == '?') {
+      size = 2 /* quotes */ + 2 + 2 * sizeof(char);  // \xAB
+    } else {
+      size = max_integral_size<uint8_t>(specs);
+    }
+  } else if constexpr (std::is_null_pointer_v<Arg>) {
+    size = 3;  // 0x0
+  } else if constexpr (is_void_pointer_v<Arg>) {
+    format_specs int_specs = specs;
+    int_specs.alternate_form = true;
+    int_specs.type = 'x';
+    size = max_integral_size<uintptr_t>(int_specs);
+  } else if constexpr (std::is_integral_v<Arg>) {
+    size = max_integral_size<Arg>(specs);
+  } else if constexpr (std::is_floating_point_v<Arg>) {
+    size = max_floating_point_size(specs);
+  } else if constexpr (std::is_same_v<Arg, std::string_view>) {
+    if (specs.type == '?' || specs.precision < 0) {
+      return std::nullopt;
+    }
+    size = static_cast<size_t>(specs.precision);
+  } else {
+    static_assert(always_false_v<Arg>, "Unknown core type!");
+  }
+  return std::max(size, static_cast<size_t>(specs.width));
+}
+
 //
 // Checks.
 //
@@ -741,7 +1008,7 @@ inline constexpr result<void> check_pointer_specs(const format_specs& specs) noe
 }
 
 inline constexpr result<void> check_floating_point_specs(const format_specs& specs) noexcept {
-  if (specs.precision > 1100) {
+  if (specs.precision > max_fp_precision) {
     return err::invalid_format;
   }
 
@@ -753,8 +1020,8 @@ inline constexpr result<void> check_floating_point_specs(const format_specs& spe
   case 'E':
   case 'g':
   case 'G':
-    //  case 'a': Not supported yet.
-    //  case 'A':
+  case 'a':
+  case 'A':
     return success;
   default:
     return err::invalid_format;
@@ -823,7 +1090,7 @@ template <typename T>
 inline constexpr bool is_core_type_v =
     std::is_same_v<T, bool> || std::is_same_v<T, char> || std::is_same_v<T, int32_t> || std::is_same_v<T, uint32_t> ||
     std::is_same_v<T, int64_t> || std::is_same_v<T, uint64_t> || std::is_same_v<T, double> ||
-    std::is_null_pointer_v<T> || is_void_pointer_v<T> || std::is_same_v<T, std::string_view>;
+    std::is_null_pointer_v<T> || is_void_pointer_v<T> || std::is_same_v<T, std::string_view> || is_int128_v<T>;
 
 template <typename T>
 concept has_format_as = requires(T arg) { format_as(arg); };
@@ -849,7 +1116,7 @@ struct unified_type<T> {
 template <typename T>
   requires(std::is_integral_v<T> && std::is_signed_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>)
 struct unified_type<T> {
-  using type = std::conditional_t<num_bits<T>() <= 32, int32_t, int64_t>;
+  using type = int32_or_64<T>;
 };
 
 template <typename T>
@@ -867,7 +1134,7 @@ struct unified_type<T> {
 template <typename T>
   requires(std::is_integral_v<T> && std::is_unsigned_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>)
 struct unified_type<T> {
-  using type = std::conditional_t<num_bits<T>() <= 32, uint32_t, uint64_t>;
+  using type = uint32_or_64<T>;
 };
 
 template <typename T>
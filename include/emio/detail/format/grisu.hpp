@@ -0,0 +1,718 @@
+//
+// Copyright (c) 2023 - present, Toni Neubert
+// All rights reserved.
+//
+// For the license information refer to emio.hpp
+
+// This implementation is based on:
+// https://github.com/rust-lang/rust/blob/71ef9ecbdedb67c32f074884f503f8e582855c2f/library/core/src/num/flt2dec/strategy/grisu.rs
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+
+#include "../predef.hpp"
+#include "decode.hpp"
+#include "dragon.hpp"
+
+namespace emio::detail::format {
+
+// A custom 64-bit floating point type, representing `f * 2^e`.
+struct diy_fp {
+  uint64_t f;
+  int16_t e;
+
+  // Returns a correctly rounded product of itself and `other`.
+  [[nodiscard]] constexpr diy_fp mul(const diy_fp& other) const noexcept {
+    constexpr uint64_t mask = 0xffffffff;
+    const uint64_t a = f >> 32;
+    const uint64_t b = f & mask;
+    const uint64_t c = other.f >> 32;
+    const uint64_t d = other.f & mask;
+    const uint64_t ac = a * c;
+    const uint64_t bc = b * c;
+    const uint64_t ad = a * d;
+    const uint64_t bd = b * d;
+    const uint64_t tmp = (bd >> 32) + (ad & mask) + (bc & mask) + (uint64_t{1} << 31) /* round */;
+    return {ac + (ad >> 32) + (bc >> 32) + (tmp >> 32), static_cast<int16_t>(e + other.e + 64)};
+  }
+
+  // Normalizes itself so that the resulting mantissa is at least `2^63`.
+  [[nodiscard]] constexpr diy_fp normalize() const noexcept {
+    const int lz = std::countl_zero(f);
+    EMIO_Z_DEV_ASSERT(lz < 64);
+    return {f << lz, static_cast<int16_t>(e - lz)};
+  }
+
+  // Normalizes itself to have the shared exponent.
+  // It can only decrease the exponent (and thus increase the mantissa).
+  [[nodiscard]] constexpr diy_fp normalize_to(int16_t new_e) const noexcept {
+    const int edelta = e - new_e;
+    EMIO_Z_DEV_ASSERT(edelta >= 0);
+    EMIO_Z_DEV_ASSERT(((f << edelta) >> edelta) == f);
+    return {f << edelta, new_e};
+  }
+};
+
+// See the comments in `format_shortest_opt` for the rationale.
+inline constexpr int16_t grisu_alpha = -60;
+inline constexpr int16_t grisu_gamma = -32;
+
+struct cached_pow10_t {
+  uint64_t f;
+  int16_t e;
+  int16_t k;
+};
+
+// The following Python code generates this table:
+// for i in range(-308, 333, 8):
+//     if i >= 0: f = 10**i; e = 0
+//     else: f = 2**(80-4*i) // 10**-i; e = 4 * i - 80
+//     l = f.bit_length()
+//     f = ((f << 64 >> (l-1)) + 1) >> 1; e += l - 64
+//     print('    {%#018x, %5d, %4d},' % (f, e, i))
+inline constexpr std::array<cached_pow10_t, 81> cached_pow10{{
+    {0xe61acf033d1a45df, -1087, -308},
+    {0xab70fe17c79ac6ca, -1060, -300},
+    {0xff77b1fcbebcdc4f, -1034, -292},
+    {0xbe5691ef416bd60c, -1007, -284},
+    {0x8dd01fad907ffc3c,  -980, -276},
+    {0xd3515c2831559a83,  -954, -268},
+    {0x9d71ac8fada6c9b5,  -927, -260},
+    {0xea9c227723ee8bcb,  -901, -252},
+    {0xaecc49914078536d,  -874, -244},
+    {0x823c12795db6ce57,  -847, -236},
+    {0xc21094364dfb5637,  -821, -228},
+    {0x9096ea6f3848984f,  -794, -220},
+    {0xd77485cb25823ac7,  -768, -212},
+    {0xa086cfcd97bf97f4,  -741, -204},
+    {0xef340a98172aace5,  -715, -196},
+    {0xb23867fb2a35b28e,  -688, -188},
+    {0x84c8d4dfd2c63f3b,  -661, -180},
+    {0xc5dd44271ad3cdba,  -635, -172},
+    {0x936b9fcebb25c996,  -608, -164},
+    {0xdbac6c247d62a584,  -582, -156},
+    {0xa3ab66580d5fdaf6,  -555, -148},
+    {0xf3e2f893dec3f126,  -529, -140},
+    {0xb5b5ada8aaff80b8,  -502, -132},
+    {0x87625f056c7c4a8b,  -475, -124},
+    {0xc9bcff6034c13053,  -449, -116},
+    {0x964e858c91ba2655,  -422, -108},
+    {0xdff9772470297ebd,  -396, -100},
+    {0xa6dfbd9fb8e5b88f,  -369,  -92},
+    {0xf8a95fcf88747d94,  -343,  -84},
+    {0xb94470938fa89bcf,  -316,  -76},
+    {0x8a08f0f8bf0f156b,  -289,  -68},
+    {0xcdb02555653131b6,  -263,  -60},
+    {0x993fe2c6d07b7fac,  -236,  -52},
+    {0xe45c10c42a2b3b06,  -210,  -44},
+    {0xaa242499697392d3,  -183,  -36},
+    {0xfd87b5f28300ca0e,  -157,  -28},
+    {0xbce5086492111aeb,  -130,  -20},
+    {0x8cbccc096f5088cc,  -103,  -12},
+    {0xd1b71758e219652c,   -77,   -4},
+    {0x9c40000000000000,   -50,    4},
+    {0xe8d4a51000000000,   -24,   12},
+    {0xad78ebc5ac620000,     3,   20},
+    {0x813f3978f8940984,    30,   28},
+    {0xc097ce7bc90715b3,    56,   36},
+    {0x8f7e32ce7bea5c70,    83,   44},
+    {0xd5d238a4abe98068,   109,   52},
+    {0x9f4f2726179a2245,   136,   60},
+    {0xed63a231d4c4fb27,   162,   68},
+    {0xb0de65388cc8ada8,   189,   76},
+    {0x83c7088e1aab65db,   216,   84},
+    {0xc45d1df942711d9a,   242,   92},
+    {0x924d692ca61be758,   269,  100},
+    {0xda01ee641a708dea,   295,  108},
+    {0xa26da3999aef774a,   322,  116},
+    {0xf209787bb47d6b85,   348,  124},
+    {0xb454e4a179dd1877,   375,  132},
+    {0x865b86925b9bc5c2,   402,  140},
+    {0xc83553c5c8965d3d,   428,  148},
+    {0x952ab45cfa97a0b3,   455,  156},
+    {0xde469fbd99a05fe3,   481,  164},
+    {0xa59bc234db398c25,   508,  172},
+    {0xf6c69a72a3989f5c,   534,  180},
+    {0xb7dcbf5354e9bece,   561,  188},
+    {0x88fcf317f22241e2,   588,  196},
+    {0xcc20ce9bd35c78a5,   614,  204},
+    {0x98165af37b2153df,   641,  212},
+    {0xe2a0b5dc971f303a,   667,  220},
+    {0xa8d9d1535ce3b396,   694,  228},
+    {0xfb9b7cd9a4a7443c,   720,  236},
+    {0xbb764c4ca7a44410,   747,  244},
+    {0x8bab8eefb6409c1a,   774,  252},
+    {0xd01fef10a657842c,   800,  260},
+    {0x9b10a4e5e9913129,   827,  268},
+    {0xe7109bfba19c0c9d,   853,  276},
+    {0xac2820d9623bf429,   880,  284},
+    {0x80444b5e7aa7cf85,   907,  292},
+    {0xbf21e44003acdd2d,   933,  300},
+    {0x8e679c2f5e44ff8f,   960,  308},
+    {0xd433179d9c8cb841,   986,  316},
+    {0x9e19db92b4e31ba9,  1013,  324},
+    {0xeb96bf6ebadf77d9,  1039,  332},
+}};
+
+inline constexpr int16_t cached_pow10_first_e = -1087;
+inline constexpr int16_t cached_pow10_last_e = 1039;
+
+// Returns a cached power `10^k` with an exponent `e` satisfying `alpha <= e <= gamma`.
+inline constexpr cached_pow10_t cached_power(int16_t alpha, int16_t gamma) noexcept {
+  constexpr int32_t offset = cached_pow10_first_e;
+  constexpr int32_t range = static_cast<int32_t>(cached_pow10.size()) - 1;
+  constexpr int32_t domain = cached_pow10_last_e - cached_pow10_first_e;
+  const int32_t idx = (gamma - offset) * range / domain;
+  const cached_pow10_t& cached = cached_pow10[static_cast<size_t>(idx)];
+  EMIO_Z_DEV_ASSERT(alpha <= cached.e && cached.e <= gamma);
+  static_cast<void>(alpha);
+  return cached;
+}
+
+struct max_pow10_t {
+  uint8_t kappa;
+  uint32_t ten_kappa;
+};
+
+// Given `x > 0`, returns `(k, 10^k)` such that `10^k <= x < 10^(k+1)`.
+inline constexpr max_pow10_t max_pow10_no_more_than(uint32_t x) noexcept {
+  EMIO_Z_DEV_ASSERT(x > 0);
+
+  constexpr uint32_t x9 = 1'000'000'000;
+  constexpr uint32_t x8 = 100'000'000;
+  constexpr uint32_t x7 = 10'000'000;
+  constexpr uint32_t x6 = 1'000'000;
+  constexpr uint32_t x5 = 100'000;
+  constexpr uint32_t x4 = 10'000;
+  constexpr uint32_t x3 = 1'000;
+  constexpr uint32_t x2 = 100;
+  constexpr uint32_t x1 = 10;
+
+  if (x < x4) {
+    if (x < x2) {
+      return x < x1 ? max_pow10_t{0, 1} : max_pow10_t{1, x1};
+    }
+    return x < x3 ? max_pow10_t{2, x2} : max_pow10_t{3, x3};
+  }
+  if (x < x6) {
+    return x < x5 ? max_pow10_t{4, x4} : max_pow10_t{5, x5};
+  }
+  if (x < x8) {
+    return x < x7 ? max_pow10_t{6, x6} : max_pow10_t{7, x7};
+  }
+  return x < x9 ? max_pow10_t{8, x8} : max_pow10_t{9, x9};
+}
+
+// The final phase of the shortest mode.
+//
+// We've generated all significant digits of `plus1`, but not sure if it's the optimal one.
+// For example, if `minus1` is 3.14153... and `plus1` is 3.14158..., there are 5 different shortest representation from
+// 3.14154 to 3.14158 but we only have the greatest one. We have to successively decrease the last digit and check if
+// this is the optimal repr. There are at most 9 candidates (..1 to ..9), so this is fairly quick. ("rounding" phase)
+//
+// The function checks if this "optimal" repr is actually within the ulp ranges, and also, it is possible that the
+// "second-to-optimal" repr can actually be optimal due to the rounding error. In either cases this returns
+// `std::nullopt`. ("weeding" phase)
+//
+// All arguments here are scaled by the common (but implicit) value `k`, so that:
+// - `remainder = (plus1 % 10^kappa) * k`
+// - `threshold = (plus1 - minus1) * k` (and also, `remainder < threshold`)
+// - `plus1v = (plus1 - v) * k` (and also, `threshold > plus1v` from prior invariants)
+// - `ten_kappa = 10^kappa * k`
+// - `ulp = 2^-e * k`
+inline constexpr std::optional<format_fp_result_t> round_and_weed(std::span<char> buf, int16_t exp, uint64_t remainder,
+                                                                  uint64_t threshold, uint64_t plus1v,
+                                                                  uint64_t ten_kappa, uint64_t ulp) noexcept {
+  EMIO_Z_DEV_ASSERT(!buf.empty());
+
+  // Produce two approximations to `v` (actually `plus1 - v`) within 1.5 ulps.
+  // The resulting representation should be the closest representation to both.
+  //
+  // Here `plus1 - v` is used since calculations are done with respect to `plus1` in order to avoid overflow/underflow
+  // (hence the seemingly swapped names).
+  const uint64_t plus1v_down = plus1v + ulp;  // plus1 - (v - 1 ulp)
+  const uint64_t plus1v_up = plus1v - ulp;    // plus1 - (v + 1 ulp)
+
+  // Decrease the last digit and stop at the closest representation to `v + 1 ulp`.
+  //
+  // We work with the approximated digits `w(n)`, initially equal to `plus1 - plus1 % 10^kappa`. After running the loop
+  // body `n` times, `w(n) = plus1 - plus1 % 10^kappa - n * 10^kappa`. We set `plus1w(n) = plus1 - w(n) =
+  // plus1 % 10^kappa + n * 10^kappa` (thus `remainder = plus1w(0)`) to simplify checks. Note that `plus1w(n)` is always
+  // increasing.
+  //
+  // We have three conditions to terminate. Any of them will make the loop unable to proceed, but we then have at least
+  // one valid representation known to be closest to `v + 1 ulp` anyway. We will denote them as TC1 through TC3.
+  //
+  // TC1: `w(n) <= v + 1 ulp`, i.e., this is the last repr that can be the closest one. This is equivalent to
+  // `plus1 - w(n) = plus1w(n) >= plus1 - (v + 1 ulp) = plus1v_up`. Combined with TC2 (which checks if `w(n+1)` is
+  // valid), this prevents the possible overflow on the calculation of `plus1w(n)`.
+  //
+  // TC2: `w(n+1) < minus1`, i.e., the next repr definitely does not round to `v`. This is equivalent to
+  // `plus1 - w(n) + 10^kappa = plus1w(n + 1) > plus1 - minus1 = threshold`. The left hand side can overflow, but we
+  // know `threshold > plus1v`, so if TC1 is false, `threshold - plus1w(n) > threshold - (plus1v - 1 ulp) > 1 ulp` and
+  // we can safely test if `threshold - plus1w(n) < 10^kappa` instead.
+  //
+  // TC3: `abs(w(n) - (v + 1 ulp)) <= abs(w(n+1) - (v + 1 ulp))`, i.e., the next repr is no closer to `v + 1 ulp` than
+  // the current repr. Given `z(n) = plus1v_up - plus1w(n)`, this becomes `abs(z(n)) <= abs(z(n+1))`. Again assuming
+  // that TC1 is false, we have `z(n) > 0`. We have two cases to consider:
+  // - when `z(n+1) >= 0`: TC3 becomes `z(n) <= z(n+1)`. As `plus1w(n)` is increasing, `z(n)` should be decreasing and
+  //   this is clearly false.
+  // - when `z(n+1) < 0`:
+  //   - TC3a: the precondition is `plus1v_up < plus1w(n) + 10^kappa`. Assuming TC2 is false,
+  //     `threshold >= plus1w(n) + 10^kappa` so it cannot overflow.
+  //   - TC3b: TC3 becomes `z(n) <= -z(n+1)`, i.e., `plus1v_up - plus1w(n) >= plus1w(n+1) - plus1v_up =
+  //     plus1w(n) + 10^kappa - plus1v_up`. The negated TC1 gives `plus1v_up > plus1w(n)`, so it cannot overflow or
+  //     underflow when combined with TC3a.
+  //
+  // Consequently, we should stop when `TC1 || TC2 || (TC3a && TC3b)`. The following is equal to its inverse,
+  // `!TC1 && !TC2 && (!TC3a || !TC3b)`.
+  uint64_t plus1w = remainder;  // plus1w(n) = plus1 - w(n)
+  char& last = buf.back();
+  while (plus1w < plus1v_up && threshold - plus1w >= ten_kappa &&
+         (plus1w + ten_kappa < plus1v_up || plus1v_up - plus1w >= plus1w + ten_kappa - plus1v_up)) {
+    last -= 1;
+    EMIO_Z_DEV_ASSERT(last > '0');  // The shortest repr cannot end with `0`.
+    plus1w += ten_kappa;
+  }
+
+  // Check if this representation is also the closest representation to `v - 1 ulp`.
+  //
+  // This is simply same to the terminating conditions for `v + 1 ulp`, with all `plus1v_up` replaced by `plus1v_down`
+  // instead. Overflow analysis equally holds.
+  if (plus1w < plus1v_down && threshold - plus1w >= ten_kappa &&
+      (plus1w + ten_kappa < plus1v_down || plus1v_down - plus1w >= plus1w + ten_kappa - plus1v_down)) {
+    return std::nullopt;
+  }
+
+  // Now we have the closest representation to `v` between `plus1` and `minus1`. This is too liberal, though, so we
+  // reject any `w(n)` not between `plus0` and `minus0`, i.e., `plus1 - plus1w(n) <= minus0` or
+  // `plus1 - plus1w(n) >= plus0`. We utilize the facts that `threshold = plus1 - minus1` and
+  // `plus1 - plus0 = minus0 - minus1 = 2 ulp`.
+  if (2 * ulp <= plus1w && plus1w <= threshold - 4 * ulp) {
+    return format_fp_result_t{buf, exp};
+  }
+  return std::nullopt;
+}
+
+// The shortest mode implementation for Grisu.
+// It returns `std::nullopt` when it would return an inexact representation otherwise. The caller should fall back to
+// Dragon4 in this case (which happens for roughly 0.5% of all doubles).
+inline constexpr std::optional<format_fp_result_t> format_shortest_opt(const finite_result_t& dec,
+                                                                       std::span<char> buf) noexcept {
+  EMIO_Z_DEV_ASSERT(dec.mant > 0);
+  EMIO_Z_DEV_ASSERT(dec.minus > 0);
+  EMIO_Z_DEV_ASSERT(dec.plus > 0);
+  EMIO_Z_DEV_ASSERT(dec.mant + dec.plus > dec.mant);
+  EMIO_Z_DEV_ASSERT(dec.mant - dec.minus < dec.mant);
+  EMIO_Z_DEV_ASSERT(buf.size() >= std::numeric_limits<double>::max_digits10);
+  // We need at least three bits of additional precision.
+  EMIO_Z_DEV_ASSERT(dec.mant + dec.plus < (uint64_t{1} << 61));
+
+  // Start with the normalized values with the shared exponent.
+  const diy_fp plus_norm = diy_fp{dec.mant + dec.plus, dec.exp}.normalize();
+  const diy_fp minus_norm = diy_fp{dec.mant - dec.minus, dec.exp}.normalize_to(plus_norm.e);
+  const diy_fp v_norm = diy_fp{dec.mant, dec.exp}.normalize_to(plus_norm.e);
+
+  // Find any `cached = 10^minusk` such that `alpha <= minusk + plus.e + 64 <= gamma`. Since `plus` is normalized, this
+  // means `2^(62 + alpha) <= plus * cached < 2^(64 + gamma)`; given our choices of `alpha` and `gamma`, this puts
+  // `plus * cached` into `[4, 2^32)`.
+  //
+  // It is obviously desirable to maximize `gamma - alpha`, so that we don't need many cached powers of 10, but there
+  // are some considerations:
+  // 1. We want to keep `floor(plus * cached)` within `uint32_t` since it needs a costly division. (This is not really
+  //    avoidable, remainder is required for accuracy estimation.)
+  // 2. The remainder of `floor(plus * cached)` repeatedly gets multiplied by 10, and it should not overflow.
+  //
+  // The first gives `64 + gamma <= 32`, while the second gives `10 * 2^-alpha <= 2^64`; -60 and -32 is the maximal
+  // range with this constraint, and V8 also uses them.
+  const cached_pow10_t cached = cached_power(static_cast<int16_t>(grisu_alpha - plus_norm.e - 64),
+                                             static_cast<int16_t>(grisu_gamma - plus_norm.e - 64));
+  const int16_t minusk = cached.k;
+
+  // Scale fps. This gives the maximal error of 1 ulp (proved from Theorem 5.1).
+  const diy_fp plus = plus_norm.mul({cached.f, cached.e});
+  const diy_fp minus = minus_norm.mul({cached.f, cached.e});
+  const diy_fp v = v_norm.mul({cached.f, cached.e});
+  EMIO_Z_DEV_ASSERT(plus.e == minus.e);
+  EMIO_Z_DEV_ASSERT(plus.e == v.e);
+
+  //         +- actual range of minus
+  //   | <---|---------------------- unsafe region --------------------------> |
+  //   |     |                                                                 |
+  //   |  |<--->|  | <--------------- safe region ---------------> |           |
+  //   |  |     |  |                                               |           |
+  //   |1 ulp|1 ulp|                 |1 ulp|1 ulp|                 |1 ulp|1 ulp|
+  //   |<--->|<--->|                 |<--->|<--->|                 |<--->|<--->|
+  //   |-----|-----|-------...-------|-----|-----|-------...-------|-----|-----|
+  //   |   minus   |                 |     v     |                 |   plus    |
+  // minus1     minus0           v - 1 ulp   v + 1 ulp           plus0       plus1
+  //
+  // Above `minus`, `v` and `plus` are *quantized* approximations (error < 1 ulp). As we don't know the error is
+  // positive or negative, we use two approximations spaced equally and have the maximal error of 2 ulps.
+  //
+  // The "unsafe region" is a liberal interval which we initially generate. The "safe region" is a conservative interval
+  // which we only accept. We start with the correct repr within the unsafe region, and try to find the closest repr to
+  // `v` which is also within the safe region. If we can't, we give up.
+  const uint64_t plus1 = plus.f + 1;
+  const uint64_t minus1 = minus.f - 1;
+  const auto e = static_cast<uint32_t>(-plus.e);  // Shared exponent.
+  const uint64_t e_mask = (uint64_t{1} << e) - 1;
+
+  // Divide `plus1` into integral and fractional parts. Integral parts are guaranteed to fit in `uint32_t`, since cached
+  // power guarantees `plus < 2^32` and normalized `plus.f` is always less than `2^64 - 2^4` due to the precision
+  // requirement.
+  const auto plus1int = static_cast<uint32_t>(plus1 >> e);
+  const uint64_t plus1frac = plus1 & e_mask;
+
+  // Calculate the largest `10^max_kappa` no more than `plus1` (thus `plus1 < 10^(max_kappa+1)`).
+  // This is an upper bound of `kappa` below.
+  const auto [max_kappa, max_ten_kappa] = max_pow10_no_more_than(plus1int);
+
+  size_t i = 0;
+  const auto exp = static_cast<int16_t>(max_kappa - minusk + 1);
+
+  // Theorem 6.2: if `k` is the greatest integer s.t. `0 <= y mod 10^k <= y - x`, then
+  //              `V = floor(y / 10^k) * 10^k` is in `[x, y]` and one of the shortest representations (with the
+  //              minimal number of significant digits) in that range.
+  //
+  // Find the digit length `kappa` between `(minus1, plus1)` as per Theorem 6.2. Theorem 6.2 can be adopted to exclude
+  // `x` by requiring `y mod 10^k < y - x` instead. (e.g., `x` = 32000, `y` = 32777; `kappa` = 2 since
+  // `y mod 10^3 = 777 < y - x = 777`.) The algorithm relies on the later verification phase to exclude `y`.
+  const uint64_t delta1 = plus1 - minus1;
+  const uint64_t delta1frac = delta1 & e_mask;
+
+  // Render integral parts, while checking for the accuracy at each step.
+  uint32_t ten_kappa = max_ten_kappa;  // 10^kappa
+  uint32_t remainder = plus1int;       // Digits yet to be rendered.
+  while (true) {
+    // We always have at least one digit to render, as `plus1 >= 10^kappa`.
+    // Invariants:
+    // - `delta1int <= remainder < 10^(kappa+1)`
+    // - `plus1int = d[0..n-1] * 10^(kappa+1) + remainder`
+    //   (it follows that `remainder = plus1int % 10^(kappa+1)`)
+
+    // Divide `remainder` by `10^kappa`. Both are scaled by `2^-e`.
+    const uint32_t q = remainder / ten_kappa;
+    const uint32_t r = remainder % ten_kappa;
+    EMIO_Z_DEV_ASSERT(q < 10);
+    buf[i] = static_cast<char>('0' + q);
+    i += 1;
+
+    const uint64_t plus1rem = (static_cast<uint64_t>(r) << e) + plus1frac;  // == (plus1 % 10^kappa) * 2^e
+    if (plus1rem < delta1) {
+      // `plus1 % 10^kappa < delta1 = plus1 - minus1`; we've found the correct `kappa`.
+      return round_and_weed(buf.subspan(0, i), exp, plus1rem, delta1, plus1 - v.f,
+                            static_cast<uint64_t>(ten_kappa) << e,  // Scale 10^kappa back to the shared exponent.
+                            1);
+    }
+
+    // Break the loop when we have rendered all integral digits.
+    // The exact number of digits is `max_kappa + 1` as `plus1 < 10^(max_kappa+1)`.
+    if (i > max_kappa) {
+      EMIO_Z_DEV_ASSERT(ten_kappa == 1);
+      break;
+    }
+
+    // Restore invariants.
+    ten_kappa /= 10;
+    remainder = r;
+  }
+
+  // Render fractional parts, while checking for the accuracy at each step.
+  // This time we rely on repeated multiplications, as division will lose the precision.
+  uint64_t frac_remainder = plus1frac;
+  uint64_t threshold = delta1frac;
+  uint64_t ulp = 1;
+  while (true) {
+    // The next digit should be significant as we've tested that before breaking out.
+    // Invariants, where `m = max_kappa + 1` (# of digits in the integral part):
+    // - `remainder < 2^e`
+    // - `plus1frac * 10^(n-m) = d[m..n-1] * 2^e + remainder`
+
+    frac_remainder *= 10;  // Won't overflow, `2^e * 10 < 2^64`.
+    threshold *= 10;
+    ulp *= 10;
+
+    // Divide `remainder` by `10^kappa`.
+    // Both are scaled by `2^e / 10^kappa`, so the latter is implicit here.
+    const uint64_t q = frac_remainder >> e;
+    const uint64_t r = frac_remainder & e_mask;
+    EMIO_Z_DEV_ASSERT(q < 10);
+    buf[i] = static_cast<char>('0' + q);
+    i += 1;
+
+    if (r < threshold) {
+      return round_and_weed(buf.subspan(0, i), exp, r, threshold, (plus1 - v.f) * ulp,
+                            uint64_t{1} << e,  // Implicit divisor.
+                            ulp);
+    }
+
+    // Restore invariants.
+    frac_remainder = r;
+  }
+}
+
+// The final phase of the exact mode.
+//
+// We've generated all requested digits of `v`, which should be also same to corresponding digits of `v - 1 ulp`. Now we
+// check if there is a unique representation shared by both `v - 1 ulp` and `v + 1 ulp`; this can be either same to
+// generated digits, or to the rounded-up version of those digits. If the range contains multiple representations of
+// the same length, we cannot be sure and should return `std::nullopt` instead.
+//
+// All arguments here are scaled by the common (but implicit) value `k`, so that:
+// - `remainder = (v % 10^kappa) * k`
+// - `ten_kappa = 10^kappa * k`
+// - `ulp = 2^-e * k`
+inline constexpr std::optional<format_fp_result_t> possibly_round(std::span<char> buf, size_t len, int16_t exp,
+                                                                  int16_t limit, uint64_t remainder, uint64_t ten_kappa,
+                                                                  uint64_t ulp) noexcept {
+  EMIO_Z_DEV_ASSERT(remainder < ten_kappa);
+
+  //           10^kappa
+  //    :   :   :<->:   :
+  //    :   :   :   :   :
+  //    :|1 ulp|1 ulp|  :
+  //    :|<--->|<--->|  :
+  // ----|-----|-----|----
+  //     |     v     |
+  // v - 1 ulp   v + 1 ulp
+  //
+  // (For the reference, the dotted line indicates the exact value for possible representations in given number of
+  // digits.)
+  //
+  // Error is too large that there are at least three possible representations between `v - 1 ulp` and `v + 1 ulp`.
+  // We cannot determine which one is correct.
+  if (ulp >= ten_kappa) {
+    return std::nullopt;
+  }
+
+  //    10^kappa
+  //   :<------->:
+  //   :         :
+  //   : |1 ulp|1 ulp|
+  //   : |<--->|<--->|
+  // ----|-----|-----|----
+  //     |     v     |
+  // v - 1 ulp   v + 1 ulp
+  //
+  // In fact, 1/2 ulp is enough to introduce two possible representations. (Remember that we need a unique
+  // representation for both `v - 1 ulp` and `v + 1 ulp`.) This won't overflow, as `ulp < ten_kappa` from the first
+  // check.
+  if (ten_kappa - ulp <= ulp) {
+    return std::nullopt;
+  }
+
+  //     remainder
+  //       :<->|                           :
+  //       :   |                           :
+  //       :<--------- 10^kappa ---------->:
+  //     | :   |                           :
+  //     |1 ulp|1 ulp|                     :
+  //     |<--->|<--->|                     :
+  // ----|-----|-----|------------------------
+  //     |     v     |
+  // v - 1 ulp   v + 1 ulp
+  //
+  // If `v + 1 ulp` is closer to the rounded-down representation (which is already in `buf`), then we can safely
+  // return. Note that `v - 1 ulp` *can* be less than the current representation, but as `1 ulp < 10^kappa / 2`, this
+  // condition is enough: the distance between `v - 1 ulp` and the current representation cannot exceed `10^kappa / 2`.
+  //
+  // The condition equals to `remainder + ulp < 10^kappa / 2`. As this can easily overflow, first check if
+  // `remainder < 10^kappa / 2`. We've already verified that `ulp < 10^kappa / 2`, so as long as `10^kappa` did not
+  // overflow after all, the second check is fine.
+  if (ten_kappa - remainder > remainder && ten_kappa - 2 * remainder >= 2 * ulp) {
+    return format_fp_result_t{buf.subspan(0, len), exp};
+  }
+
+  //   :<------- remainder ------>|   :
+  //   :                          |   :
+  //   :<--------- 10^kappa --------->:
+  //   :                    |     |   : |
+  //   :                    |1 ulp|1 ulp|
+  //   :                    |<--->|<--->|
+  // -----------------------|-----|-----|-----
+  //                        |     v     |
+  //                    v - 1 ulp   v + 1 ulp
+  //
+  // On the other hands, if `v - 1 ulp` is closer to the rounded-up representation, we should round up and return.
+  // For the same reason we don't need to check `v + 1 ulp`.
+  //
+  // The condition equals to `remainder - ulp >= 10^kappa / 2`. Again we first check if `remainder > ulp` (note that
+  // this is not `remainder >= ulp`, as `10^kappa` is never zero). Also note that `remainder - ulp <= 10^kappa`, so the
+  // second check does not overflow.
+  if (remainder > ulp && ten_kappa - (remainder - ulp) <= remainder - ulp) {
+    if (const std::optional<char> c = round_up(buf.subspan(0, len))) {
+      // Only add an additional digit if the original buffer was empty and we've been requested the fixed precision
+      // (same as Dragon4). The additional digit can only be added when `exp == limit` (edge case).
+      exp += 1;
+      if (exp > limit && len == 0 && !buf.empty()) {
+        buf[len] = *c;
+        len += 1;
+      }
+    }
+    return format_fp_result_t{buf.subspan(0, len), exp};
+  }
+
+  // Otherwise we are doomed (i.e., some values between `v - 1 ulp` and `v + 1 ulp` are rounding up and others are
+  // rounding down) and give up.
+  return std::nullopt;
+}
+
+// Grisu renders at most 10 integral digits (`uint32_t`) and 18 fractional digits (`10^18 > 2^59`) of the scaled value.
+// A request for more digits always fails.
+inline constexpr size_t grisu_exact_max_digits = 28;
+
+// The exact and fixed mode implementation for Grisu.
+// The digits are rendered into `buf`, which must be large enough to hold all requested digits (see
+// `grisu_exact_max_digits`). It returns `std::nullopt` when it would return an inexact representation otherwise. The
+// caller should fall back to Dragon4 in this case.
+inline constexpr std::optional<format_fp_result_t> format_exact_opt(const finite_result_t& dec, std::span<char> buf,
+                                                                    format_exact_mode mode,
+                                                                    int16_t number_of_digits) noexcept {
+  EMIO_Z_DEV_ASSERT(dec.mant > 0);
+  // We need at least three bits of additional precision.
+  EMIO_Z_DEV_ASSERT(dec.mant < (uint64_t{1} << 61));
+
+  if (mode == format_exact_mode::significand_digits && number_of_digits <= 0) {
+    return std::nullopt;  // Edge case handled by Dragon4.
+  }
+
+  // Normalize and scale `v`.
+  const diy_fp v_norm = diy_fp{dec.mant, dec.exp}.normalize();
+  const cached_pow10_t cached = cached_power(static_cast<int16_t>(grisu_alpha - v_norm.e - 64),
+                                             static_cast<int16_t>(grisu_gamma - v_norm.e - 64));
+  const int16_t minusk = cached.k;
+  const diy_fp v = v_norm.mul({cached.f, cached.e});
+
+  // Divide `v` into integral and fractional parts.
+  const auto e = static_cast<uint32_t>(-v.e);
+  const uint64_t e_mask = (uint64_t{1} << e) - 1;
+  const auto vint = static_cast<uint32_t>(v.f >> e);
+  const uint64_t vfrac = v.f & e_mask;
+
+  // Both old `v` and new `v` (scaled by `10^-k`) has an error of < 1 ulp (Theorem 5.1). As we don't know the error is
+  // positive or negative, we use two approximations spaced equally and have the maximal error of 2 ulps (same to the
+  // shortest case).
+  //
+  // The goal is to find the exactly rounded series of digits that are common to both `v - 1 ulp` and `v + 1 ulp`, so
+  // that we are maximally confident. If this is not possible, we don't know which one is the correct output for `v`,
+  // so we give up and fall back.
+  //
+  // `err` is defined as `1 ulp * 2^e` here (same to the ulp in `vfrac`), and we will scale it whenever `v` gets scaled.
+  uint64_t err = 1;
+
+  // Calculate the largest `10^max_kappa` no more than `v` (thus `v < 10^(max_kappa+1)`).
+  // This is an upper bound of `kappa` below.
+  const auto [max_kappa, max_ten_kappa] = max_pow10_no_more_than(vint);
+
+  const auto exp = static_cast<int16_t>(max_kappa - minusk + 1);
+
+  // If we are working with the last-digit limitation, we need to shorten the buffer before the actual rendering in
+  // order to avoid double rounding.
+  int16_t limit = std::numeric_limits<int16_t>::min();
+  size_t len = static_cast<size_t>(number_of_digits);
+  if (mode == format_exact_mode::decimal_point) {
+    limit = static_cast<int16_t>(-number_of_digits);
+    if (exp <= limit) {
+      // Oops, we cannot even produce *one* digit. This is possible when, say, we've got something like 9.5 and it's
+      // being rounded to 10.
+      //
+      // In principle we can immediately call `possibly_round` with an empty buffer, but scaling `max_ten_kappa << e` by
+      // 10 can result in overflow. Thus we are being sloppy here and widen the error range by a factor of 10. This will
+      // increase the false negative rate, but only very, *very* slightly; it can only matter noticeably when the
+      // mantissa is bigger than 60 bits.
+      return possibly_round(buf, 0, exp, limit, v.f / 10, static_cast<uint64_t>(max_ten_kappa) << e, err);
+    }
+    len = static_cast<size_t>(exp - limit);
+  }
+  if (len > buf.size() || len > grisu_exact_max_digits) {
+    return std::nullopt;
+  }
+  EMIO_Z_DEV_ASSERT(len > 0);
+
+  // Render integral parts.
+  // The error is entirely fractional, so we don't need to check it in this part.
+  size_t i = 0;
+  uint32_t ten_kappa = max_ten_kappa;  // 10^kappa
+  uint32_t remainder = vint;           // Digits yet to be rendered.
+  while (true) {
+    // We always have at least one digit to render.
+    // Invariants:
+    // - `remainder < 10^(kappa+1)`
+    // - `vint = d[0..n-1] * 10^(kappa+1) + remainder`
+    //   (it follows that `remainder = vint % 10^(kappa+1)`)
+
+    // Divide `remainder` by `10^kappa`. Both are scaled by `2^-e`.
+    const uint32_t q = remainder / ten_kappa;
+    const uint32_t r = remainder % ten_kappa;
+    EMIO_Z_DEV_ASSERT(q < 10);
+    buf[i] = static_cast<char>('0' + q);
+    i += 1;
+
+    // Is the buffer full? Run the rounding pass with the remainder.
+    if (i == len) {
+      const uint64_t vrem = (static_cast<uint64_t>(r) << e) + vfrac;  // == (v % 10^kappa) * 2^e
+      return possibly_round(buf, len, exp, limit, vrem, static_cast<uint64_t>(ten_kappa) << e, err);
+    }
+
+    // Break the loop when we have rendered all integral digits.
+    // The exact number of digits is `max_kappa + 1` as `plus1 < 10^(max_kappa+1)`.
+    if (i > max_kappa) {
+      EMIO_Z_DEV_ASSERT(ten_kappa == 1);
+      break;
+    }
+
+    // Restore invariants.
+    ten_kappa /= 10;
+    remainder = r;
+  }
+
+  // Render fractional parts.
+  //
+  // In principle we can continue to the last available digit and check for the accuracy. Unfortunately we are working
+  // with the finite-sized integers, so we need some criterion to detect the overflow. V8 uses `remainder > err`, which
+  // becomes false when the first `i` significant digits of `v - 1 ulp` and `v` differ. However this rejects too many
+  // otherwise valid input.
+  //
+  // Since the later phase has a correct overflow detection, we instead use tighter criterion: we continue til `err`
+  // exceeds `10^kappa / 2`, so that the range between `v - 1 ulp` and `v + 1 ulp` definitely contains two or more
+  // rounded representations. This is same to the first two comparisons from `possibly_round`, for the reference.
+  uint64_t frac_remainder = vfrac;
+  const uint64_t maxerr = uint64_t{1} << (e - 1);
+  while (err < maxerr) {
+    // Invariants, where `m = max_kappa + 1` (# of digits in the integral part):
+    // - `remainder < 2^e`
+    // - `vfrac * 10^(n-m) = d[m..n-1] * 2^e + remainder`
+    // - `err = 10^(n-m)`
+
+    frac_remainder *= 10;  // Won't overflow, `2^e * 10 < 2^64`.
+    err *= 10;             // Won't overflow, `err * 10 < 2^e * 5 < 2^64`.
+
+    // Divide `remainder` by `10^kappa`.
+    // Both are scaled by `2^e / 10^kappa`, so the latter is implicit here.
+    const uint64_t q = frac_remainder >> e;
+    const uint64_t r = frac_remainder & e_mask;
+    EMIO_Z_DEV_ASSERT(q < 10);
+    buf[i] = static_cast<char>('0' + q);
+    i += 1;
+
+    // Is the buffer full? Run the rounding pass with the remainder.
+    if (i == len) {
+      return possibly_round(buf, len, exp, limit, r, uint64_t{1} << e, err);
+    }
+
+    // Restore invariants.
+    frac_remainder = r;
+  }
+
+  // Further calculation is useless (`possibly_round` definitely fails), so we give up.
+  return std::nullopt;
+}
+
+}  // namespace emio::detail::format
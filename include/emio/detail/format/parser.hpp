@@ -23,7 +23,7 @@ class format_parser final : public parser<format_parser, input_validation::disab
   constexpr ~format_parser() noexcept override;  // NOLINT(performance-trivially-destructible): See definition.
 
   constexpr result<void> process(const std::string_view& str) noexcept override {
-    return out_.write_str(str);
+    return out_.write_literal(str);
   }
 
   result<void> process_arg(const format_arg& arg) noexcept {
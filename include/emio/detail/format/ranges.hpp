@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <optional>
 #include <span>
 #include <string_view>
 #include <tuple>
@@ -67,6 +69,70 @@ struct ranges_specs {
   std::string_view separator{};
 };
 
+// Contiguous ranges of arithmetic types are formatted in bulk. The element formatter must provide an upper bound of its
+// output size.
+template <typename T>
+concept is_bulk_formattable = is_span<T>::value && std::is_arithmetic_v<element_type_t<T>> &&
+                              requires(const formatter<element_type_t<T>> f) { f.max_formatted_size(); };
+
+// The maximum size of a write area requested at once to format multiple elements of a range in bulk.
+inline constexpr size_t max_bulk_write_area_size{4 * 1024};
+
+// Elements with a larger upper bound output size (e.g. fixed floating-points) are formatted one by one because the
+// write areas would be mostly unused.
+inline constexpr size_t max_bulk_element_size{64};
+
+// Formats the elements of a contiguous range separated by the separator. Instead of requesting a write area for each
+// element and separator, one write area is requested for as many elements as fit by their upper bound output size.
+// The elements are formatted into the write area in one loop and the unused end of the write area is released.
+template <typename Formatter, typename Span>
+constexpr result<void> format_bulk(writer& out, const Formatter& element_formatter, const Span& elements,
+                                   const std::string_view separator) noexcept {
+  const std::optional<size_t> max_element_size = element_formatter.max_formatted_size();
+  EMIO_Z_DEV_ASSERT(max_element_size.has_value());
+  const size_t max_size = *max_element_size + separator.size();
+  buffer& buf = out.get_buffer();
+
+  auto it = elements.begin();
+  const auto last = elements.end();
+  const auto format_one = [&]() noexcept -> result<void> {
+    if (it != elements.begin()) {
+      EMIO_TRYV(out.write_str(separator));
+    }
+    return element_formatter.format(out, *it++);
+  };
+
+  if (max_size > max_bulk_element_size) {
+    while (it != last) {
+      EMIO_TRYV(format_one());
+    }
+    return success;
+  }
+
+  while (it != last) {
+    const auto remaining = static_cast<size_t>(last - it);
+    EMIO_TRY(const std::span<char> area,
+             buf.get_write_area_of_max(std::min(remaining * max_size, max_bulk_write_area_size)));
+    const size_t cnt = area.size() / max_size;
+    if (cnt == 0) {  // The buffer cannot provide enough space at once.
+      buf.release_write_area(area.size());
+      EMIO_TRYV(format_one());
+      continue;
+    }
+
+    span_buffer area_buf{area};
+    writer area_out{area_buf};
+    for (const auto chunk_last = it + static_cast<std::ptrdiff_t>(cnt); it != chunk_last; ++it) {
+      if (it != elements.begin()) {
+        EMIO_TRYV(area_out.write_str(separator));
+      }
+      EMIO_TRYV(element_formatter.format(area_out, *it));
+    }
+    buf.release_write_area(area.size() - area_buf.view().size());
+  }
+  return success;
+}
+
 template <typename Formatter>
   requires requires(Formatter f) { f.set_debug_format(true); }
 constexpr void maybe_set_debug_format(Formatter& f, bool set) noexcept {
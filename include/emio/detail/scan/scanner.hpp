@@ -133,6 +133,45 @@ constexpr result<void> read_arg(reader& original_in, const format_specs& specs,
   return success;
 }
 
+inline constexpr float_format get_float_format(char type) noexcept {
+  switch (type) {
+  case 'e':
+    return float_format::scientific;
+  case 'f':
+    return float_format::fixed;
+  case 'g':
+  case no_type:
+    return float_format::general;
+  default:
+    EMIO_Z_DEV_ASSERT(false);
+    EMIO_Z_INTERNAL_UNREACHABLE;
+  }
+}
+
+template <typename Arg>
+  requires(std::is_floating_point_v<Arg>)
+constexpr result<void> read_arg(reader& original_in, const format_specs& specs, Arg& arg) noexcept {
+  reader in = original_in;
+  if (specs.width != no_width) {
+    if (in.cnt_remaining() < static_cast<size_t>(specs.width)) {
+      return err::eof;
+    }
+    EMIO_TRY(in, in.subreader(0, static_cast<size_t>(specs.width)));
+  }
+
+  EMIO_TRY(arg, parse_float<Arg>(in, get_float_format(specs.type)));
+
+  if (specs.width != no_width) {
+    if (!in.eof()) {
+      return err::invalid_data;
+    }
+    original_in.pop(static_cast<size_t>(specs.width));
+  } else {
+    original_in = in;
+  }
+  return success;
+}
+
 template <typename Arg>
   requires(std::is_same_v<Arg, char>)
 constexpr result<void> read_arg(reader& in, const format_specs& /*unused*/, Arg& arg) noexcept {
@@ -311,6 +350,21 @@ inline constexpr result<void> check_integral_specs(const format_specs& specs) no
   }
 }
 
+inline constexpr result<void> check_floating_point_specs(const format_specs& specs) noexcept {
+  if (specs.alternate_form) {
+    return err::invalid_format;
+  }
+  switch (specs.type) {
+  case no_type:
+  case 'e':
+  case 'f':
+  case 'g':
+    return success;
+  default:
+    return err::invalid_format;
+  }
+}
+
 inline constexpr result<void> check_string_specs(const format_specs& specs) noexcept {
   if ((specs.type != no_type && specs.type != 's') || specs.alternate_form) {
     return err::invalid_format;
@@ -345,7 +399,8 @@ concept has_any_validate_function_v =
 template <typename T>
 inline constexpr bool is_core_type_v =
     std::is_same_v<T, char> || std::is_same_v<T, int32_t> || std::is_same_v<T, uint32_t> ||
-    std::is_same_v<T, int64_t> || std::is_same_v<T, uint64_t>;
+    std::is_same_v<T, int64_t> || std::is_same_v<T, uint64_t> || std::is_same_v<T, float> ||
+    std::is_same_v<T, double> || is_int128_v<T>;
 
 }  // namespace detail::scan
 
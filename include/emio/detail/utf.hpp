@@ -6,6 +6,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
 #include <span>
@@ -14,6 +17,7 @@
 
 #include "../buffer.hpp"
 #include "conversion.hpp"
+#include "find.hpp"
 
 namespace emio::detail {
 
@@ -21,17 +25,79 @@ inline constexpr bool needs_escape(uint32_t cp) noexcept {
   return cp < 0x20 || cp >= 0x7f || cp == '\'' || cp == '"' || cp == '\\';
 }
 
-inline constexpr size_t count_size_when_escaped(std::string_view sv) noexcept {
-  size_t count = 0;
-  for (const char c : sv) {
-    if (!needs_escape(static_cast<uint32_t>(c))) {
-      count += 1;
-    } else if (c == '\n' || c == '\r' || c == '\t' || c == '\\' || c == '\'' || c == '"') {
-      count += 2;
-    } else {
-      count += 2 + 2 * sizeof(char);  // \xAB...
+// Searches the first char which needs to be escaped.
+constexpr const char* find_escape_scalar(const char* it, const char* const end) noexcept {
+  for (; it != end; ++it) {
+    if (needs_escape(static_cast<uint32_t>(*it))) {
+      return it;
+    }
+  }
+  return end;
+}
+
+#if !defined(EMIO_OPTIMIZE_FOR_SIZE) && \
+    (defined(EMIO_Z_INTERNAL_FIND_AVX2) || defined(EMIO_Z_INTERNAL_FIND_SSE2) || defined(EMIO_Z_INTERNAL_FIND_NEON))
+
+// Tests a whole vector of input chars at once. Compared as signed integers, control chars and all non-ASCII chars
+// (>= 0x80) are less than a space.
+inline const char* find_escape_vector(const char* it, const char* const end) noexcept {
+  const find_vector_t space = find_broadcast(' ');
+  const find_vector_t del = find_broadcast('\x7f');
+  const find_vector_t backslash = find_broadcast('\\');
+  const find_vector_t single_quote = find_broadcast('\'');
+  const find_vector_t double_quote = find_broadcast('"');
+
+  for (; static_cast<size_t>(end - it) >= find_vector_size; it += find_vector_size) {
+    const find_vector_t input = find_load(it);
+    const find_vector_t matches =
+        find_or(find_or(find_cmp_lt(input, space), find_cmp_eq(input, del)),
+                find_or(find_cmp_eq(input, backslash),
+                        find_or(find_cmp_eq(input, single_quote), find_cmp_eq(input, double_quote))));
+    const uint64_t mask = find_mask(matches);
+    if (mask != 0) {
+      return it + std::countr_zero(mask) / find_mask_bits_per_char;
     }
   }
+  return find_escape_scalar(it, end);
+}
+
+#endif
+
+/**
+ * Searches the first char which needs to be escaped.
+ * @param begin The begin of the input.
+ * @param end The end of the input.
+ * @return The position of the found char or end.
+ */
+constexpr const char* find_escape(const char* const begin, const char* const end) noexcept {
+#if !defined(EMIO_OPTIMIZE_FOR_SIZE) && \
+    (defined(EMIO_Z_INTERNAL_FIND_AVX2) || defined(EMIO_Z_INTERNAL_FIND_SSE2) || defined(EMIO_Z_INTERNAL_FIND_NEON))
+  if (!EMIO_Z_INTERNAL_IS_CONST_EVAL && static_cast<size_t>(end - begin) >= min_find_group_vector_size) {
+    return find_escape_vector(begin, end);
+  }
+#endif
+  return find_escape_scalar(begin, end);
+}
+
+// Returns the size of the escape sequence of a char which needs to be escaped.
+inline constexpr size_t escape_sequence_size(const char c) noexcept {
+  if (c == '\n' || c == '\r' || c == '\t' || c == '\\' || c == '\'' || c == '"') {
+    return 2;
+  }
+  return 2 + 2 * sizeof(char);  // \xAB...
+}
+
+// The maximum size of an escape sequence.
+inline constexpr size_t max_escape_sequence_size{2 + 2 * sizeof(char)};
+
+inline constexpr size_t count_size_when_escaped(std::string_view sv) noexcept {
+  const char* it = detail::begin(sv);
+  const char* const end = detail::end(sv);
+  size_t count = sv.size();
+  // Skip the runs of chars which need no escaping.
+  while ((it = find_escape(it, end)) != end) {
+    count += escape_sequence_size(*it++) - 1;
+  }
   return count;
 }
 
@@ -59,10 +125,14 @@ class write_escaped_helper {
       if (dst_it == dst_end) {
         return static_cast<size_t>(dst_it - area.data());
       }
-      const char c = *src_it_++;
-      if (!needs_escape(static_cast<uint32_t>(c))) {
-        *(dst_it++) = c;
-      } else {
+      // Copy the run of chars which need no escaping at once.
+      const auto max_run = std::min(src_end_ - src_it_, dst_end - dst_it);
+      const char* const run_end = find_escape(src_it_, src_it_ + max_run);
+      dst_it = detail::copy_n(src_it_, run_end - src_it_, dst_it);
+      src_it_ = run_end;
+
+      if (src_it_ != src_end_ && dst_it != dst_end) {
+        const char c = *src_it_++;
         *(dst_it++) = '\\';
         const auto remaining_space = static_cast<size_t>(dst_end - dst_it);
         if (remaining_space >= 3) {
@@ -79,6 +149,23 @@ class write_escaped_helper {
     return static_cast<size_t>(dst_it - area.data());
   }
 
+  /**
+   * Checks if the whole input has been escaped and written.
+   * @return True if nothing is left to write, otherwise false.
+   */
+  [[nodiscard]] constexpr bool done() const noexcept {
+    return src_it_ == src_end_ && remainder_it_ == remainder_end_;
+  }
+
+  /**
+   * Returns the maximum number of chars left to write, assuming every remaining char needs to be fully escaped.
+   * @return The upper bound.
+   */
+  [[nodiscard]] constexpr size_t max_remaining_size() const noexcept {
+    return static_cast<size_t>(src_end_ - src_it_) * max_escape_sequence_size +
+           static_cast<size_t>(remainder_end_ - remainder_it_);
+  }
+
  private:
   [[nodiscard]] static inline constexpr char* write_escaped(const char c, char* out) noexcept {
     switch (c) {
@@ -123,9 +210,18 @@ class write_escaped_helper {
   char* remainder_end_{};
 };
 
-inline constexpr result<void> write_str_escaped(buffer& buf, std::string_view sv, size_t escaped_size,
+/**
+ * Writes a char sequence escaped and quoted into a buffer.
+ * The sequence is escaped in multiple chunks, to support buffers with an internal cache.
+ * @param buf The buffer.
+ * @param sv The char sequence.
+ * @param escaped_size The escaped size of the char sequence or an upper bound of it. The unwritten end of the write
+ * area is released again.
+ * @param quote The quote char.
+ * @return EOF if the buffer is to small.
+ */
+inline constexpr result<void> write_str_escaped(buffer& buf, std::string_view sv, const size_t escaped_size,
                                                 const char quote) {
-  // Perform escaping in multiple chunks, to support buffers with an internal cache.
   detail::write_escaped_helper helper{sv};
   EMIO_TRY(auto area, buf.get_write_area_of_max(escaped_size + 2 /*both quotes*/));
   // Start quote.
@@ -134,19 +230,37 @@ inline constexpr result<void> write_str_escaped(buffer& buf, std::string_view sv
 
   while (true) {
     const size_t written = helper.write_escaped(area);
-    escaped_size -= written;
-    if (escaped_size == 0) {
-      area = area.subspan(written);
+    area = area.subspan(written);
+    if (helper.done()) {
       break;
     }
-    EMIO_TRY(area, buf.get_write_area_of_max(escaped_size + 1 /*end quote*/));
+    EMIO_TRY(area, buf.get_write_area_of_max(helper.max_remaining_size() + 1 /*end quote*/));
   }
   if (area.empty()) {
     EMIO_TRY(area, buf.get_write_area_of_max(1 /*end quote*/));
   }
   // End quote.
   area[0] = quote;
+  buf.release_write_area(area.size() - 1);
   return success;
 }
 
+/**
+ * Writes a char sequence escaped and quoted into a buffer.
+ * If the current write area of the buffer already provides the worst case size, the sequence is escaped in a single
+ * pass without counting its escaped size first. Otherwise, the escaped size is counted and requested exactly, so that
+ * a growing buffer doesn't grow to the worst case size.
+ * @param buf The buffer.
+ * @param sv The char sequence.
+ * @param quote The quote char.
+ * @return EOF if the buffer is to small.
+ */
+inline constexpr result<void> write_str_escaped(buffer& buf, std::string_view sv, const char quote) {
+  const size_t max_escaped_size = sv.size() * max_escape_sequence_size;
+  if (buf.get_remaining_write_area_size() >= max_escaped_size + 2 /*both quotes*/) {
+    return write_str_escaped(buf, sv, max_escaped_size, quote);
+  }
+  return write_str_escaped(buf, sv, count_size_when_escaped(sv), quote);
+}
+
 }  // namespace emio::detail
@@ -36,6 +36,7 @@
 #ifndef EMIO_Z_MAIN_H
 #define EMIO_Z_MAIN_H
 
+#include "deferred.hpp"
 #include "format.hpp"
 #include "ranges.hpp"
 #include "scan.hpp"
@@ -8,6 +8,7 @@
 
 #include <cstdio>
 
+#include "detail/format/compiled_format.hpp"
 #include "detail/format/format_to.hpp"
 #include "iterator.hpp"
 
@@ -27,6 +28,37 @@ using format_string = detail::format::format_string<Args...>;
 template <typename... Args>
 using valid_format_string = detail::format::valid_format_string<Args...>;
 
+template <size_t MaxFields, typename... Args>
+using basic_compiled_format = detail::format::basic_compiled_format<MaxFields, Args...>;
+
+/// The default maximum number of replacement fields of a compiled_format (at least one per argument).
+inline constexpr size_t default_max_compiled_fields{16};
+
+template <typename... Args>
+using compiled_format = basic_compiled_format<std::max(default_max_compiled_fields, sizeof...(Args)), Args...>;
+
+/**
+ * Compiles a format string at compile-time into a fixed sequence of literal writes and formatter calls with already
+ * parsed format specs. Can be passed instead of a format string to format, format_to and formatted_size.
+ * @note Each compiled format string instantiates its own formatting code. Therefore, this is an opt-in to trade binary
+ * size for speed.
+ * @tparam Str The format string.
+ */
+template <detail::format::fixed_string Str>
+inline constexpr detail::format::compiled_string<Str> compile{};
+
+/**
+ * An upper bound of the number of characters the formatting of any values of the argument types produces with the
+ * format string. Can be used to size a static_buffer at compile-time.
+ * @note Only available if the output size of each argument is bounded by its type and format specs (e.g. integers,
+ * chars, bools, pointers, floating-points and strings with precision).
+ * @tparam Str The format string.
+ * @tparam Args The argument types to format.
+ */
+template <detail::format::fixed_string Str, typename... Args>
+inline constexpr size_t max_formatted_size_v =
+    detail::format::compiled_string_format<Str, Args...>::max_formatted_size();
+
 /**
  * Returns an object that stores a format string with an array of all arguments to format.
  *
@@ -201,6 +233,131 @@ constexpr result<OutputIt> format_to(OutputIt out, const emio::format_string<Arg
   return buf.out();
 }
 
+/**
+ * Formats arguments according to the compiled format string, and writes the result to the output buffer.
+ * @param buf The output buffer.
+ * @param format_str The compiled format string.
+ * @param args The arguments to be formatted.
+ * @return Success or EOF if the buffer is to small.
+ */
+template <size_t MaxFields, typename... Args>
+constexpr result<void> format_to(buffer& buf, const emio::basic_compiled_format<MaxFields, Args...>& format_str,
+                                 const std::type_identity_t<Args>&... args) noexcept {
+  writer wtr{buf};
+  return format_str.format(wtr, args...);
+}
+
+/**
+ * Formats arguments according to the compiled format string, and writes the result to the writer's buffer.
+ * @param out The writer.
+ * @param format_str The compiled format string.
+ * @param args The arguments to be formatted.
+ * @return Success or EOF if the buffer is to small.
+ */
+template <size_t MaxFields, typename... Args>
+constexpr result<void> format_to(writer& out, const emio::basic_compiled_format<MaxFields, Args...>& format_str,
+                                 const std::type_identity_t<Args>&... args) noexcept {
+  return format_str.format(out, args...);
+}
+
+/**
+ * Formats arguments according to the compiled format string, and writes the result to the output iterator.
+ * @param out The output iterator.
+ * @param format_str The compiled format string.
+ * @param args The arguments to be formatted.
+ * @return The iterator past the end of the output range on success or EOF if the buffer is to small.
+ */
+template <typename OutputIt, size_t MaxFields, typename... Args>
+  requires(std::output_iterator<OutputIt, char>)
+constexpr result<OutputIt> format_to(OutputIt out,
+                                     const emio::basic_compiled_format<MaxFields, Args...>& format_str,
+                                     const std::type_identity_t<Args>&... args) noexcept {
+  iterator_buffer buf{out};
+  writer wtr{buf};
+  EMIO_TRYV(format_str.format(wtr, args...));
+  return buf.out();
+}
+
+/**
+ * Determines the total number of characters in the formatted string by formatting args according to the compiled
+ * format string.
+ * @param format_str The compiled format string.
+ * @param args The arguments to be formatted.
+ * @return The total number of characters in the formatted string.
+ */
+template <size_t MaxFields, typename... Args>
+constexpr result<size_t> formatted_size(const emio::basic_compiled_format<MaxFields, Args...>& format_str,
+                                        const std::type_identity_t<Args>&... args) noexcept {
+  detail::counting_buffer buf{};
+  writer wtr{buf};
+  EMIO_TRYV(format_str.format(wtr, args...));
+  return buf.count();
+}
+
+/**
+ * Formats arguments according to the compile-time compiled format string, and writes the result to the output buffer.
+ * @param buf The output buffer.
+ * @param format_str The compiled format string.
+ * @param args The arguments to be formatted.
+ * @return Success or EOF if the buffer is to small.
+ */
+template <detail::format::fixed_string Str, typename... Args>
+constexpr result<void> format_to(buffer& buf, detail::format::compiled_string<Str> /*format_str*/,
+                                 const Args&... args) noexcept {
+  writer wtr{buf};
+  return detail::format::compiled_string_format<Str, Args...>::format(wtr, args...);
+}
+
+/**
+ * Formats arguments according to the compile-time compiled format string, and writes the result to the writer's
+ * buffer.
+ * @param out The writer.
+ * @param format_str The compiled format string.
+ * @param args The arguments to be formatted.
+ * @return Success or EOF if the buffer is to small.
+ */
+template <detail::format::fixed_string Str, typename... Args>
+constexpr result<void> format_to(writer& out, detail::format::compiled_string<Str> /*format_str*/,
+                                 const Args&... args) noexcept {
+  return detail::format::compiled_string_format<Str, Args...>::format(out, args...);
+}
+
+/**
+ * Formats arguments according to the compile-time compiled format string, and writes the result to the output
+ * iterator.
+ * @param out The output iterator.
+ * @param format_str The compiled format string.
+ * @param args The arguments to be formatted.
+ * @return The iterator past the end of the output range on success or EOF if the buffer is to small.
+ */
+template <typename OutputIt, detail::format::fixed_string Str, typename... Args>
+  requires(std::output_iterator<OutputIt, char>)
+constexpr result<OutputIt> format_to(OutputIt out, detail::format::compiled_string<Str> /*format_str*/,
+                                     const Args&... args) noexcept {
+  iterator_buffer buf{out};
+  writer wtr{buf};
+  EMIO_TRYV((detail::format::compiled_string_format<Str, Args...>::format(wtr, args...)));
+  return buf.out();
+}
+
+/**
+ * Determines the total number of characters in the formatted string by formatting args according to the compile-time
+ * compiled format string.
+ * @note This is an optimized version where the formatting can never fail.
+ * @param format_str The compiled format string.
+ * @param args The arguments to be formatted.
+ * @return The total number of characters in the formatted string.
+ */
+template <detail::format::fixed_string Str, typename... Args>
+  requires(!format_can_fail_v<Args> && ...)
+[[nodiscard]] constexpr size_t formatted_size(detail::format::compiled_string<Str> /*format_str*/,
+                                              const Args&... args) noexcept(detail::exceptions_disabled) {
+  detail::counting_buffer buf{};
+  writer wtr{buf};
+  detail::format::compiled_string_format<Str, Args...>::format(wtr, args...).value();
+  return buf.count();
+}
+
 #if __STDC_HOSTED__
 /**
  * Formats arguments according to the format string, and returns the result as string.
@@ -254,6 +411,51 @@ template <typename T, typename... Args>
 result<std::string> format(T format_str, const Args&... args) noexcept {
   return emio::vformat(emio::make_format_args(format_str, args...));
 }
+
+/**
+ * Formats arguments according to the compile-time compiled format string, and returns the result as string.
+ * @note This is an optimized version where the formatting can never fail.
+ * @param format_str The compiled format string.
+ * @param args The arguments to be formatted.
+ * @return The string.
+ */
+template <detail::format::fixed_string Str, typename... Args>
+  requires(!format_can_fail_v<Args> && ...)
+[[nodiscard]] std::string format(detail::format::compiled_string<Str> format_str,
+                                 const Args&... args) noexcept(detail::exceptions_disabled) {
+  memory_buffer buf;
+  emio::format_to(buf, format_str, args...).value();  // Should never fail.
+  return buf.str();
+}
+
+/**
+ * Formats arguments according to the compile-time compiled format string, and returns the result as string.
+ * @param format_str The compiled format string.
+ * @param args The arguments to be formatted.
+ * @return The string on success or an error of the formatter of an argument.
+ */
+template <detail::format::fixed_string Str, typename... Args>
+  requires(format_can_fail_v<Args> || ...)
+[[nodiscard]] result<std::string> format(detail::format::compiled_string<Str> format_str,
+                                         const Args&... args) noexcept {
+  memory_buffer buf;
+  EMIO_TRYV(emio::format_to(buf, format_str, args...));
+  return buf.str();
+}
+
+/**
+ * Formats arguments according to the compiled format string, and returns the result as string.
+ * @param format_str The compiled format string.
+ * @param args The arguments to be formatted.
+ * @return The string on success or an error of the formatter of an argument.
+ */
+template <size_t MaxFields, typename... Args>
+result<std::string> format(const emio::basic_compiled_format<MaxFields, Args...>& format_str,
+                           const std::type_identity_t<Args>&... args) noexcept {
+  memory_buffer buf;
+  EMIO_TRYV(emio::format_to(buf, format_str, args...));
+  return buf.str();
+}
 #endif
 
 /**
@@ -352,6 +554,59 @@ constexpr result<size_t> format_to_n(buffer& buf, size_t n, const emio::format_s
   return trunc_buf.count();
 }
 
+namespace detail {
+
+#if __STDC_HOSTED__
+
+// Thread-local print buffers which have grown larger than this are released after the print.
+inline constexpr size_t max_retained_print_buffer_size{64 * 1024};
+
+inline result<void> format_print_to(buffer& buf, const format_args& args, const bool new_line) noexcept {
+  EMIO_TRYV(detail::format::vformat_to(buf, args));
+  if (new_line) {
+    EMIO_TRY(auto area, buf.get_write_area_of(1));
+    area[0] = '\n';
+  }
+  return success;
+}
+
+inline result<void> write_print_to(std::FILE* file, const std::string_view str) noexcept {
+  if (std::fwrite(str.data(), sizeof(char), str.size(), file) != str.size()) {
+    return err::eof;
+  }
+  return success;
+}
+
+// Formats the whole output into a thread-local buffer and writes it with a single fwrite call. Therefore, the outputs
+// of concurrent prints don't interleave and the file stream is locked only once per print.
+inline result<void> vprint_atomically(std::FILE* file, const format_args& args, const bool new_line) noexcept {
+  thread_local memory_buffer print_buf;
+  thread_local bool print_buf_in_use{};
+
+  // A print from inside of a formatter uses its own buffer.
+  if (print_buf_in_use) {
+    memory_buffer buf;
+    EMIO_TRYV(format_print_to(buf, args, new_line));
+    return write_print_to(file, buf.view());
+  }
+
+  print_buf_in_use = true;
+  print_buf.reset();
+  result<void> res = format_print_to(print_buf, args, new_line);
+  if (res) {
+    res = write_print_to(file, print_buf.view());
+  }
+  if (print_buf.capacity() > max_retained_print_buffer_size) {
+    print_buf = memory_buffer{};
+  }
+  print_buf_in_use = false;
+  return res;
+}
+
+#endif
+
+}  // namespace detail
+
 /**
  * Formats arguments according to the format string, and writes the result to a file stream.
  * @param file The file stream.
@@ -487,4 +742,90 @@ result<void> println(std::FILE* file, const emio::format_string<Args...>& format
   return vprintln(file, emio::make_format_args(format_str, args...));
 }
 
+#if __STDC_HOSTED__
+
+/**
+ * Formats arguments according to the format string, and writes the result to a file stream with a single fwrite call.
+ * @note The whole output is formatted into a thread-local buffer first. Therefore, the outputs of concurrent prints
+ * don't interleave and the file stream is locked only once per print.
+ * @param file The file stream.
+ * @param args The format args with the format string.
+ * @return Success or EOF if the file stream is not writable or invalid_format if the format string validation failed.
+ */
+inline result<void> vprint_atomic(std::FILE* file, const format_args& args) noexcept {
+  if (file == nullptr) {
+    return err::invalid_data;
+  }
+  return detail::vprint_atomically(file, args, false);
+}
+
+/**
+ * Formats arguments according to the format string, and writes the result to the standard output stream with a
+ * single fwrite call.
+ * @param format_str The format string.
+ * @param args The arguments to be formatted.
+ * @return Success or EOF if the file stream is not writable or invalid_format if the format string validation failed.
+ */
+template <typename... Args>
+result<void> print_atomic(const emio::format_string<Args...>& format_str, const Args&... args) noexcept {
+  return vprint_atomic(stdout, emio::make_format_args(format_str, args...));
+}
+
+/**
+ * Formats arguments according to the format string, and writes the result to a file stream with a single fwrite call.
+ * @param file The file stream.
+ * @param format_str The format string.
+ * @param args The arguments to be formatted.
+ * @return Success or EOF if the file stream is not writable or invalid_format if the format string validation failed.
+ */
+template <typename... Args>
+result<void> print_atomic(std::FILE* file, const emio::format_string<Args...>& format_str,
+                          const Args&... args) noexcept {
+  return vprint_atomic(file, emio::make_format_args(format_str, args...));
+}
+
+/**
+ * Formats arguments according to the format string, and writes the result to a file stream with a new line at the end
+ * with a single fwrite call.
+ * @note The whole output is formatted into a thread-local buffer first. Therefore, the outputs of concurrent prints
+ * don't interleave and the file stream is locked only once per print.
+ * @param file The file stream.
+ * @param args The format args with the format string.
+ * @return Success or EOF if the file stream is not writable or invalid_format if the format string validation failed.
+ */
+inline result<void> vprintln_atomic(std::FILE* file, const format_args& args) noexcept {
+  if (file == nullptr) {
+    return err::invalid_data;
+  }
+  return detail::vprint_atomically(file, args, true);
+}
+
+/**
+ * Formats arguments according to the format string, and writes the result to the standard output stream with a new
+ * line at the end with a single fwrite call.
+ * @param format_str The format string.
+ * @param args The arguments to be formatted.
+ * @return Success or EOF if the file stream is not writable or invalid_format if the format string validation failed.
+ */
+template <typename... Args>
+result<void> println_atomic(const emio::format_string<Args...>& format_str, const Args&... args) noexcept {
+  return vprintln_atomic(stdout, emio::make_format_args(format_str, args...));
+}
+
+/**
+ * Formats arguments according to the format string, and writes the result to a file stream with a new line at the end
+ * with a single fwrite call.
+ * @param file The file stream.
+ * @param format_str The format string.
+ * @param args The arguments to be formatted.
+ * @return Success or EOF if the file stream is not writable or invalid_format if the format string validation failed.
+ */
+template <typename... Args>
+result<void> println_atomic(std::FILE* file, const emio::format_string<Args...>& format_str,
+                            const Args&... args) noexcept {
+  return vprintln_atomic(file, emio::make_format_args(format_str, args...));
+}
+
+#endif
+
 }  // namespace emio
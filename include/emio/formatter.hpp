@@ -123,6 +123,15 @@ class formatter<T> {
     return write_arg(out, specs, arg);
   }
 
+  /**
+   * Returns an upper bound of the number of characters the formatting of any value produces with the parsed format
+   * specs.
+   * @return The upper bound or nullopt if the output size isn't bounded (e.g. a string without precision).
+   */
+  [[nodiscard]] constexpr std::optional<size_t> max_formatted_size() const noexcept {
+    return detail::format::max_formatted_size<T>(specs_);
+  }
+
   /**
    * Enables or disables the debug output format.
    * @note Used e.g. from range formatter.
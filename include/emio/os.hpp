@@ -0,0 +1,864 @@
+//
+// Copyright (c) 2021 - present, Toni Neubert
+// All rights reserved.
+//
+// For the license information refer to emio.hpp
+
+#pragma once
+
+// Opt-in header for POSIX systems. Not included by emio.hpp.
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <iterator>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <utility>
+
+#include "buffer.hpp"
+#include "reader.hpp"
+#include "stream_reader.hpp"
+
+namespace emio {
+
+/// The size of a memory page the output of the POSIX buffers is aligned to.
+inline constexpr size_t page_size{4096};
+
+/// The default cache size of an fd_buffer.
+inline constexpr size_t default_fd_cache_size{4 * page_size};
+
+/// The default maximum number of segments an iovec_buffer collects before writing them.
+inline constexpr size_t default_iovec_segments{64};
+
+/// The default size the file of an mmap_file_buffer is extended by.
+inline constexpr size_t default_mmap_grow_size{16 * 1024 * 1024};
+
+/// The default number of slots of a ring_buffer_sink.
+inline constexpr size_t default_ring_slot_count{256};
+
+/// The default size of a slot of a ring_buffer_sink.
+inline constexpr size_t default_ring_slot_size{256};
+
+/// The default size of each of the two buffers of an async_fd_buffer.
+inline constexpr size_t default_async_buffer_size{16 * page_size};
+
+/// The default interval after which an async_fd_buffer hands a partially filled buffer over to its writer thread.
+inline constexpr std::chrono::milliseconds default_async_flush_interval{100};
+
+namespace detail {
+
+// Writes all characters to the file descriptor. Partial writes are continued and interrupted writes are repeated.
+inline result<void> write_all(int fd, const char* data, size_t size) noexcept {
+  while (size != 0) {
+    const ssize_t written = ::write(fd, data, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return err::eof;
+    }
+    data += written;
+    size -= static_cast<size_t>(written);
+  }
+  return success;
+}
+
+// Reads up to size characters from the file descriptor. Interrupted reads are repeated.
+inline result<size_t> read_some(int fd, char* data, size_t size) noexcept {
+  while (true) {
+    const ssize_t cnt = ::read(fd, data, size);
+    if (cnt >= 0) {
+      return static_cast<size_t>(cnt);
+    }
+    if (errno != EINTR) {
+      return err::eof;
+    }
+  }
+}
+
+// Writes all segments to the file descriptor. Partial writes are continued and interrupted writes are repeated.
+// The segments are modified in case of partial writes.
+inline result<void> writev_all(int fd, iovec* segments, size_t cnt) noexcept {
+  while (cnt != 0) {
+    const ssize_t written = ::writev(fd, segments, static_cast<int>(std::min<size_t>(cnt, IOV_MAX)));
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return err::eof;
+    }
+    // Skip the completely written segments and adjust the partially written one.
+    auto remaining = static_cast<size_t>(written);
+    while (cnt != 0 && remaining >= segments->iov_len) {
+      remaining -= segments->iov_len;
+      ++segments;
+      --cnt;
+    }
+    if (remaining != 0) {
+      segments->iov_base = static_cast<char*>(segments->iov_base) + remaining;
+      segments->iov_len -= remaining;
+    }
+  }
+  return success;
+}
+
+}  // namespace detail
+
+/**
+ * This class fulfills the buffer API by writing directly to a POSIX file descriptor with an internal cache.
+ * Bypasses the std::FILE stream and its locking. If the cache runs full, only whole pages are written if possible and
+ * the remainder is kept in the cache. Therefore, the file offset mostly stays page aligned until the final flush.
+ * @note The file descriptor isn't closed by the buffer.
+ * @tparam CacheSize The size of the internal cache. Must be a multiple of the page size.
+ */
+template <size_t CacheSize = default_fd_cache_size>
+  requires(CacheSize != 0 && CacheSize % page_size == 0)
+class fd_buffer final : public buffer {
+ public:
+  /**
+   * Constructs and initializes the buffer with the given file descriptor.
+   * @param fd The file descriptor.
+   */
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init): cache_ can be left uninitialized
+  explicit fd_buffer(int fd) noexcept : fd_{fd} {
+    this->set_write_area(cache_);
+  }
+
+  fd_buffer(const fd_buffer&) = delete;
+  fd_buffer(fd_buffer&&) = delete;
+  fd_buffer& operator=(const fd_buffer&) = delete;
+  fd_buffer& operator=(fd_buffer&&) = delete;
+  ~fd_buffer() override = default;
+
+  /**
+   * Writes the internal cache to the file descriptor.
+   * @return Success or EOF if the file descriptor is not writable.
+   */
+  result<void> flush() noexcept {
+    EMIO_TRYV(detail::write_all(fd_, cache_.data(), pending_ + this->get_used_count()));
+    pending_ = 0;
+    this->set_write_area(cache_);
+    return success;
+  }
+
+ protected:
+  result<std::span<char>> request_write_area(const size_t used, const size_t size) noexcept override {
+    const size_t cached = pending_ + used;
+    const size_t flushable = cached - cached % page_size;
+    EMIO_TRYV(detail::write_all(fd_, cache_.data(), flushable));
+    pending_ = cached - flushable;
+    if (pending_ != 0) {
+      // A request larger than the cache is served partially anyway. Otherwise, the request must fit completely.
+      if (size > CacheSize || CacheSize - pending_ >= size) {
+        std::copy_n(cache_.data() + flushable, pending_, cache_.data());
+      } else {
+        EMIO_TRYV(detail::write_all(fd_, cache_.data() + flushable, pending_));
+        pending_ = 0;
+      }
+    }
+
+    const std::span<char> area = std::span{cache_}.subspan(pending_);
+    this->set_write_area(area);
+    if (size > area.size()) {
+      return area;
+    }
+    return area.subspan(0, size);
+  }
+
+ private:
+  int fd_;
+  size_t pending_{};  // Characters in front of the current write area which are not written yet.
+  std::array<char, CacheSize> cache_;
+};
+
+/**
+ * This class fulfills the buffer API by collecting the output as segments which are written with a single writev(2)
+ * call to a POSIX file descriptor. Literals of format strings are referenced instead of being copied into the cache.
+ * Only the formatted replacement fields and short literals are copied into the internal cache.
+ * @note The format strings (and therefore their literals) must stay valid until the buffer is flushed.
+ * @note The file descriptor isn't closed by the buffer.
+ * @tparam CacheSize The size of the internal cache for the formatted output.
+ * @tparam MaxSegments The maximum number of segments collected before they are written.
+ */
+template <size_t CacheSize = default_cache_size, size_t MaxSegments = default_iovec_segments>
+  requires(CacheSize != 0 && MaxSegments >= 3)
+class iovec_buffer final : public buffer {
+ public:
+  /// Literals shorter than this are copied because an own segment isn't cheaper than copying them.
+  static constexpr size_t min_literal_reference_size{32};
+
+  /**
+   * Constructs and initializes the buffer with the given file descriptor.
+   * @param fd The file descriptor.
+   */
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init): cache_ and segments_ can be left uninitialized
+  explicit iovec_buffer(int fd) noexcept : buffer{fixed_size::no, literal_reference::yes}, fd_{fd} {
+    this->set_write_area(cache_);
+  }
+
+  iovec_buffer(const iovec_buffer&) = delete;
+  iovec_buffer(iovec_buffer&&) = delete;
+  iovec_buffer& operator=(const iovec_buffer&) = delete;
+  iovec_buffer& operator=(iovec_buffer&&) = delete;
+  ~iovec_buffer() override = default;
+
+  /**
+   * Writes the collected segments to the file descriptor.
+   * @return Success or EOF if the file descriptor is not writable.
+   */
+  result<void> flush() noexcept {
+    return write_segments(this->get_used_count());
+  }
+
+ protected:
+  result<std::span<char>> request_write_area(const size_t used, const size_t size) noexcept override {
+    EMIO_TRYV(write_segments(used));
+    const std::span<char> area{cache_};
+    if (size > area.size()) {
+      return area;
+    }
+    return area.subspan(0, size);
+  }
+
+  result<bool> request_literal_reference(size_t used, const std::string_view str) noexcept override {
+    if (str.size() < min_literal_reference_size) {
+      return false;
+    }
+    // Room for the closed cache segment, the literal and the cache segment of the next flush.
+    if (segment_cnt_ + 3 > MaxSegments) {
+      EMIO_TRYV(write_segments(used));
+      used = 0;
+    }
+    // Close the segment of the cache written so far and continue in the cache after it.
+    add_segment(cache_.data() + segment_begin_, used);
+    segment_begin_ += used;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast): iovec requires a mutable pointer, writev doesn't modify
+    add_segment(const_cast<char*>(str.data()), str.size());
+    this->set_write_area(std::span{cache_}.subspan(segment_begin_));
+    return true;
+  }
+
+ private:
+  void add_segment(char* data, const size_t size) noexcept {
+    if (size != 0) {
+      segments_[segment_cnt_++] = iovec{data, size};
+    }
+  }
+
+  result<void> write_segments(const size_t used) noexcept {
+    add_segment(cache_.data() + segment_begin_, used);
+    const size_t cnt = std::exchange(segment_cnt_, 0);
+    segment_begin_ = 0;
+    this->set_write_area(cache_);
+    return detail::writev_all(fd_, segments_.data(), cnt);
+  }
+
+  int fd_;
+  size_t segment_cnt_{};
+  size_t segment_begin_{};  // Start of the current write area inside the cache.
+  std::array<iovec, MaxSegments> segments_;
+  std::array<char, CacheSize> cache_;
+};
+
+/**
+ * This class fulfills the buffer API by providing write areas directly inside a memory-mapped file. The file is
+ * extended in large chunks and truncated to the exact written size on close. The output is written from the start of
+ * the file and replaces its previous content.
+ * @note The file descriptor must be opened for reading and writing. It isn't closed by the buffer.
+ */
+class mmap_file_buffer final : public buffer {
+ public:
+  /**
+   * Constructs and initializes the buffer with the given file descriptor. The file is mapped on the first write.
+   * @param fd The file descriptor.
+   * @param grow_size The size the file is extended by if the mapping runs full. Rounded up to the page size.
+   */
+  explicit mmap_file_buffer(int fd, size_t grow_size = default_mmap_grow_size) noexcept
+      : fd_{fd}, grow_size_{round_up_to_page(std::max(grow_size, size_t{1}))} {}
+
+  mmap_file_buffer(const mmap_file_buffer&) = delete;
+  mmap_file_buffer(mmap_file_buffer&&) = delete;
+  mmap_file_buffer& operator=(const mmap_file_buffer&) = delete;
+  mmap_file_buffer& operator=(mmap_file_buffer&&) = delete;
+
+  /**
+   * Closes the buffer if not already done.
+   */
+  ~mmap_file_buffer() override {
+    static_cast<void>(close());
+  }
+
+  /**
+   * Returns the number of written characters.
+   * @return The size.
+   */
+  [[nodiscard]] size_t size() const noexcept {
+    return size_ + this->get_used_count();
+  }
+
+  /**
+   * Unmaps the file and truncates it to the exact written size. Further writes map the file again and append to it.
+   * @return Success or EOF if the file couldn't be truncated.
+   */
+  result<void> close() noexcept {
+    size_ += this->get_used_count();
+    this->set_write_area({});
+    if (data_ != nullptr) {
+      ::munmap(data_, capacity_);
+      data_ = nullptr;
+      capacity_ = 0;
+    }
+    if (::ftruncate(fd_, static_cast<off_t>(size_)) != 0) {
+      return err::eof;
+    }
+    return success;
+  }
+
+ protected:
+  result<std::span<char>> request_write_area(const size_t used, const size_t size) noexcept override {
+    size_ += used;
+    if (capacity_ < size_ + size) {
+      EMIO_TRYV(grow(std::max(capacity_ + grow_size_, round_up_to_page(size_ + size))));
+    }
+    const std::span<char> area{data_ + size_, capacity_ - size_};
+    this->set_write_area(area);
+    return area.subspan(0, size);
+  }
+
+ private:
+  static constexpr size_t round_up_to_page(const size_t size) noexcept {
+    return (size + page_size - 1) / page_size * page_size;
+  }
+
+  result<void> grow(const size_t capacity) noexcept {
+    if (::ftruncate(fd_, static_cast<off_t>(capacity)) != 0) {
+      return err::eof;
+    }
+    void* data{};
+#if defined(MREMAP_MAYMOVE)
+    if (data_ != nullptr) {
+      data = ::mremap(data_, capacity_, capacity, MREMAP_MAYMOVE);
+    } else {
+      data = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    }
+#else
+    if (data_ != nullptr) {
+      ::munmap(data_, capacity_);
+      data_ = nullptr;
+      capacity_ = 0;
+    }
+    data = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+#endif
+    if (data == MAP_FAILED) {
+      return err::eof;
+    }
+    data_ = static_cast<char*>(data);
+    capacity_ = capacity;
+    return success;
+  }
+
+  int fd_;
+  size_t grow_size_;
+  char* data_{};
+  size_t capacity_{};
+  size_t size_{};  // Characters in front of the current write area.
+};
+
+/**
+ * This class is a bounded lock-free ring buffer of fixed-size slots, which multiple producer threads format into
+ * concurrently and a single consumer thread drains to a POSIX file descriptor. A producer reserves a slot with one
+ * atomic increment, formats directly into it through the buffer API of the slot and commits it. The consumer writes the
+ * committed records in reservation order with writev(2).
+ * If all slots are in use, a producer waits until the consumer has drained the oldest one.
+ * @note Records larger than a slot are truncated.
+ * @tparam SlotCount The number of slots. Must be a power of two and at least two.
+ * @tparam SlotSize The maximum size of a record.
+ */
+template <size_t SlotCount = default_ring_slot_count, size_t SlotSize = default_ring_slot_size>
+  requires(std::has_single_bit(SlotCount) && SlotCount >= 2 && SlotSize != 0)
+class ring_buffer_sink {
+ private:
+  // Each slot starts at its own cache line to avoid false sharing between the producers.
+  struct alignas(64) slot_storage {
+    std::atomic<size_t> sequence;  // Position + 1 if committed, position + SlotCount if drained.
+    size_t size;
+    std::array<char, SlotSize> data;
+  };
+
+ public:
+  /**
+   * This class fulfills the buffer API by providing the storage of one reserved slot of a ring_buffer_sink. The record
+   * is committed on destruction, if not committed before.
+   */
+  class slot final : public buffer {
+   public:
+    slot(const slot&) = delete;
+    slot(slot&&) = delete;
+    slot& operator=(const slot&) = delete;
+    slot& operator=(slot&&) = delete;
+
+    ~slot() override {
+      commit();
+    }
+
+    /**
+     * Commits the record written so far to the consumer. Nothing can be written into the slot afterwards.
+     */
+    void commit() noexcept {
+      if (storage_ == nullptr) {
+        return;
+      }
+      storage_->size = this->get_used_count();
+      storage_->sequence.store(position_ + 1, std::memory_order_release);
+      storage_ = nullptr;
+      this->set_write_area({});
+    }
+
+   private:
+    friend class ring_buffer_sink;
+
+    slot(slot_storage& storage, const size_t position) noexcept
+        : buffer{fixed_size::yes}, storage_{&storage}, position_{position} {
+      this->set_write_area(storage.data);
+    }
+
+    slot_storage* storage_;
+    size_t position_;
+  };
+
+  /**
+   * Constructs an empty ring buffer.
+   */
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init): data and size of the slots can be left uninitialized
+  ring_buffer_sink() noexcept {
+    for (size_t i = 0; i < SlotCount; i++) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  ring_buffer_sink(const ring_buffer_sink&) = delete;
+  ring_buffer_sink(ring_buffer_sink&&) = delete;
+  ring_buffer_sink& operator=(const ring_buffer_sink&) = delete;
+  ring_buffer_sink& operator=(ring_buffer_sink&&) = delete;
+  ~ring_buffer_sink() = default;
+
+  /**
+   * Reserves the next slot to format a record into. Waits until the slot is drained if all slots are in use.
+   * @note Thread-safe. The records are drained in the order of their reservation, therefore a reserved slot must be
+   * committed in a timely manner.
+   * @return The slot.
+   */
+  [[nodiscard]] slot reserve() noexcept {
+    const size_t position = head_.fetch_add(1, std::memory_order_relaxed);
+    slot_storage& storage = slots_[position & (SlotCount - 1)];
+    while (storage.sequence.load(std::memory_order_acquire) != position) {
+      std::this_thread::yield();
+    }
+    return slot{storage, position};
+  }
+
+  /**
+   * Writes all committed records in reservation order to the file descriptor. Stops at the first record which is not
+   * committed yet. The drained slots are released even if the file descriptor is not writable.
+   * @note Must only be called by one thread at a time.
+   * @param fd The file descriptor.
+   * @return The number of drained records or EOF if the file descriptor is not writable.
+   */
+  result<size_t> drain_to(const int fd) noexcept {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init): only the filled segments are used
+    std::array<iovec, default_iovec_segments> segments;
+    size_t drained = 0;
+    while (true) {
+      size_t cnt = 0;
+      for (; cnt < segments.size(); cnt++) {
+        slot_storage& storage = slots_[(tail_ + cnt) & (SlotCount - 1)];
+        if (storage.sequence.load(std::memory_order_acquire) != tail_ + cnt + 1) {
+          break;
+        }
+        segments[cnt] = iovec{storage.data.data(), storage.size};
+      }
+      if (cnt == 0) {
+        return drained;
+      }
+      const result<void> res = detail::writev_all(fd, segments.data(), cnt);
+      for (size_t i = 0; i < cnt; i++, tail_++) {
+        slots_[tail_ & (SlotCount - 1)].sequence.store(tail_ + SlotCount, std::memory_order_release);
+      }
+      EMIO_TRYV(res);
+      drained += cnt;
+    }
+  }
+
+ private:
+  alignas(64) std::atomic<size_t> head_{};  // Next position to reserve.
+  alignas(64) size_t tail_{};               // Next position to drain.
+  std::array<slot_storage, SlotCount> slots_;
+};
+
+/**
+ * This class fulfills the buffer API by formatting into one of two buffers while a background thread writes the other
+ * one to a POSIX file descriptor. The buffers are swapped if the active one is full or if the flush interval has
+ * elapsed since the last swap. Therefore, the formatting thread only waits for the file descriptor if the background
+ * thread hasn't finished writing the previous buffer yet.
+ * @note The flush interval is checked whenever a page of the active buffer is filled. Output which is formatted before
+ * a pause of the formatting thread is only written by the next swap, flush or the destruction.
+ * The file descriptor isn't closed by the buffer. Write errors of the background thread are reported by the next swap
+ * or flush.
+ * @tparam BufferSize The size of each of the two buffers. Must be a multiple of the page size.
+ */
+template <size_t BufferSize = default_async_buffer_size>
+  requires(BufferSize != 0 && BufferSize % page_size == 0)
+class async_fd_buffer final : public buffer {
+ public:
+  /**
+   * Constructs and initializes the buffer with the given file descriptor and starts the background thread.
+   * @param fd The file descriptor.
+   * @param flush_interval The interval after which a partially filled buffer is written.
+   */
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init): buffers_ can be left uninitialized
+  explicit async_fd_buffer(int fd, std::chrono::milliseconds flush_interval = default_async_flush_interval) noexcept
+      : fd_{fd}, flush_interval_{flush_interval}, last_swap_{clock::now()}, writer_{[this] {
+          write_loop();
+        }} {
+    this->set_write_area(next_write_area(0));
+  }
+
+  async_fd_buffer(const async_fd_buffer&) = delete;
+  async_fd_buffer(async_fd_buffer&&) = delete;
+  async_fd_buffer& operator=(const async_fd_buffer&) = delete;
+  async_fd_buffer& operator=(async_fd_buffer&&) = delete;
+
+  /**
+   * Flushes the buffer and stops the background thread.
+   */
+  ~async_fd_buffer() override {
+    static_cast<void>(flush());
+    {
+      const std::lock_guard lock{mutex_};
+      stop_ = true;
+    }
+    cv_.notify_all();
+    writer_.join();
+  }
+
+  /**
+   * Hands the active buffer over to the background thread and waits until everything is written to the file
+   * descriptor.
+   * @return Success or EOF if the file descriptor is not writable.
+   */
+  result<void> flush() noexcept {
+    filled_ += this->get_used_count();
+    const result<void> res = swap_buffers();
+    this->set_write_area(next_write_area(0));
+
+    std::unique_lock lock{mutex_};
+    cv_.wait(lock, [this] {
+      return pending_size_ == 0;
+    });
+    if (std::exchange(failed_, false)) {
+      return err::eof;
+    }
+    return res;
+  }
+
+ protected:
+  result<std::span<char>> request_write_area(const size_t used, const size_t size) noexcept override {
+    filled_ += used;
+    const size_t remaining = BufferSize - filled_;
+    // A request larger than a buffer is served partially anyway. Otherwise, the request must fit completely.
+    const bool fits = size > BufferSize ? remaining != 0 : remaining >= size;
+    result<void> res = success;
+    if (filled_ != 0 && (!fits || clock::now() - last_swap_ >= flush_interval_)) {
+      res = swap_buffers();
+    }
+
+    const std::span<char> area = next_write_area(size);
+    this->set_write_area(area);
+    EMIO_TRYV(res);
+    if (size > area.size()) {
+      return area;
+    }
+    return area.subspan(0, size);
+  }
+
+ private:
+  using clock = std::chrono::steady_clock;
+
+  // Returns the next write area inside of the active buffer. It is limited to a page (if possible) to check the flush
+  // interval regularly.
+  std::span<char> next_write_area(const size_t size) noexcept {
+    const size_t area_size = std::min(BufferSize - filled_, std::max(size, page_size));
+    return std::span{buffers_[active_]}.subspan(filled_, area_size);
+  }
+
+  // Waits until the background thread is idle and hands the filled part of the active buffer over to it.
+  result<void> swap_buffers() noexcept {
+    std::unique_lock lock{mutex_};
+    cv_.wait(lock, [this] {
+      return pending_size_ == 0;
+    });
+    const bool failed = std::exchange(failed_, false);
+    if (filled_ != 0) {
+      pending_data_ = buffers_[active_].data();
+      pending_size_ = filled_;
+      lock.unlock();
+      cv_.notify_all();
+      active_ ^= 1U;
+      filled_ = 0;
+    }
+    last_swap_ = clock::now();
+    if (failed) {
+      return err::eof;
+    }
+    return success;
+  }
+
+  // The loop of the background thread, which writes the handed over buffers.
+  void write_loop() noexcept {
+    std::unique_lock lock{mutex_};
+    while (true) {
+      cv_.wait(lock, [this] {
+        return pending_size_ != 0 || stop_;
+      });
+      if (pending_size_ == 0) {
+        return;
+      }
+      lock.unlock();
+      const bool failed = !detail::write_all(fd_, pending_data_, pending_size_);
+      lock.lock();
+      failed_ = failed_ || failed;
+      pending_size_ = 0;
+      cv_.notify_all();
+    }
+  }
+
+  int fd_;
+  std::chrono::milliseconds flush_interval_;
+  clock::time_point last_swap_;
+  size_t active_{};  // Index of the buffer which is formatted into.
+  size_t filled_{};  // Characters of the active buffer in front of the current write area.
+  std::array<std::array<char, BufferSize>, 2> buffers_;
+
+  // Shared with the background thread.
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  const char* pending_data_{};
+  size_t pending_size_{};  // Characters handed over to the background thread. Zero if it is idle.
+  bool failed_{};          // If a write of the background thread failed.
+  bool stop_{};
+
+  // Declared last to start the background thread after all other members are initialized.
+  std::thread writer_;
+};
+
+/**
+ * This class fulfills the stream reader API by reading from a POSIX file descriptor.
+ * @note The file descriptor isn't closed by the stream reader.
+ * @tparam CacheSize The size of the internal cache.
+ */
+template <size_t CacheSize = default_stream_cache_size>
+class fd_stream_reader final : public stream_reader {
+ public:
+  /**
+   * Constructs and initializes the stream reader with the given file descriptor.
+   * @param fd The file descriptor.
+   */
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init): cache_ can be left uninitialized
+  explicit fd_stream_reader(int fd) noexcept : stream_reader{cache_}, fd_{fd} {}
+
+  fd_stream_reader(const fd_stream_reader&) = delete;
+  fd_stream_reader(fd_stream_reader&&) = delete;
+  fd_stream_reader& operator=(const fd_stream_reader&) = delete;
+  fd_stream_reader& operator=(fd_stream_reader&&) = delete;
+  ~fd_stream_reader() override = default;
+
+ protected:
+  result<size_t> request_input(const std::span<char> area) noexcept override {
+    return detail::read_some(fd_, area.data(), area.size());
+  }
+
+ private:
+  int fd_;
+  std::array<char, CacheSize> cache_;
+};
+
+/**
+ * A range over the records of a reader separated by a delimiter (e.g. the lines of a text). Each record is read with
+ * read_until_char(delimiter). The delimiter isn't part of the records.
+ */
+class record_range {
+ public:
+  /**
+   * The iterator over the records.
+   */
+  class iterator {
+   public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = std::string_view;
+
+    constexpr iterator() = default;
+
+    constexpr iterator(const reader& rdr, const char delimiter) noexcept : rdr_{rdr}, delimiter_{delimiter} {
+      read_next();
+    }
+
+    constexpr const std::string_view& operator*() const noexcept {
+      return record_;
+    }
+
+    constexpr iterator& operator++() noexcept {
+      read_next();
+      return *this;
+    }
+
+    constexpr void operator++(int) noexcept {
+      read_next();
+    }
+
+    friend constexpr bool operator==(const iterator& it, std::default_sentinel_t /*unused*/) noexcept {
+      return it.end_;
+    }
+
+   private:
+    constexpr void read_next() noexcept {
+      const result<std::string_view> record = rdr_.read_until_char(delimiter_);
+      end_ = !record;
+      if (record) {
+        record_ = *record;
+      }
+    }
+
+    reader rdr_{};
+    char delimiter_{};
+    std::string_view record_{};
+    bool end_{true};
+  };
+
+  /**
+   * Constructs the range.
+   * @param rdr The reader to read the records from.
+   * @param delimiter The delimiter between the records.
+   */
+  constexpr record_range(const reader& rdr, const char delimiter) noexcept : rdr_{rdr}, delimiter_{delimiter} {}
+
+  [[nodiscard]] constexpr iterator begin() const noexcept {
+    return iterator{rdr_, delimiter_};
+  }
+
+  [[nodiscard]] constexpr std::default_sentinel_t end() const noexcept {
+    return {};
+  }
+
+ private:
+  reader rdr_;
+  char delimiter_;
+};
+
+/**
+ * This class maps a file read-only into memory for zero-copy reading and scanning. The mapping is advised for
+ * sequential access. String views returned by readers over the mapping point directly into it.
+ * @note The file descriptor isn't closed by the mapping and can be closed after mapping.
+ */
+class mmap_file {
+ public:
+  /**
+   * Maps the whole file of the given file descriptor read-only into memory.
+   * @param fd The file descriptor.
+   * @return The mapping or EOF if the file couldn't be mapped.
+   */
+  static result<mmap_file> map(int fd) noexcept {
+    struct stat file_stat {};
+    if (::fstat(fd, &file_stat) != 0) {
+      return err::eof;
+    }
+    const auto size = static_cast<size_t>(file_stat.st_size);
+    if (size == 0) {  // An empty mapping is invalid.
+      return mmap_file{nullptr, 0};
+    }
+    void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      return err::eof;
+    }
+    ::madvise(data, size, MADV_SEQUENTIAL);
+    return mmap_file{static_cast<const char*>(data), size};
+  }
+
+  mmap_file(const mmap_file&) = delete;
+  mmap_file& operator=(const mmap_file&) = delete;
+
+  mmap_file(mmap_file&& other) noexcept
+      : data_{std::exchange(other.data_, nullptr)}, size_{std::exchange(other.size_, 0)} {}
+
+  mmap_file& operator=(mmap_file&& other) noexcept {
+    if (this != &other) {
+      unmap();
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+
+  ~mmap_file() {
+    unmap();
+  }
+
+  /**
+   * Obtains a view over the mapped file.
+   * @return The view.
+   */
+  [[nodiscard]] std::string_view view() const noexcept {
+    return {data_, size_};
+  }
+
+  /**
+   * Obtains a reader over the mapped file.
+   * @return The reader.
+   */
+  [[nodiscard]] reader get_reader() const noexcept {
+    return reader{view()};
+  }
+
+  /**
+   * Obtains a range over the records of the mapped file.
+   * @param delimiter The delimiter between the records.
+   * @return The range.
+   */
+  [[nodiscard]] record_range records(const char delimiter) const noexcept {
+    return record_range{get_reader(), delimiter};
+  }
+
+  /**
+   * Obtains a range over the lines of the mapped file.
+   * @return The range.
+   */
+  [[nodiscard]] record_range lines() const noexcept {
+    return records('\n');
+  }
+
+ private:
+  mmap_file(const char* data, size_t size) noexcept : data_{data}, size_{size} {}
+
+  void unmap() noexcept {
+    if (data_ != nullptr) {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast): munmap requires a mutable pointer
+      ::munmap(const_cast<char*>(data_), size_);
+    }
+  }
+
+  const char* data_;
+  size_t size_;
+};
+
+}  // namespace emio
@@ -78,15 +78,19 @@ class formatter<T> {
   constexpr result<void> format(writer& out, const T& arg) const noexcept {
     EMIO_TRYV(out.write_str(specs_.opening_bracket));
 
-    using std::begin;
-    using std::end;
-    auto first = begin(arg);
-    const auto last = end(arg);
-    for (auto it = first; it != last; ++it) {
-      if (it != first) {
-        EMIO_TRYV(out.write_str(specs_.separator));
+    if constexpr (detail::format::is_bulk_formattable<T>) {
+      EMIO_TRYV(detail::format::format_bulk(out, underlying_, arg, specs_.separator));
+    } else {
+      using std::begin;
+      using std::end;
+      auto first = begin(arg);
+      const auto last = end(arg);
+      for (auto it = first; it != last; ++it) {
+        if (it != first) {
+          EMIO_TRYV(out.write_str(specs_.separator));
+        }
+        EMIO_TRYV(underlying_.format(out, *it));
       }
-      EMIO_TRYV(underlying_.format(out, *it));
     }
     EMIO_TRYV(out.write_str(specs_.closing_bracket));
     return success;
@@ -12,6 +12,8 @@
 #include <type_traits>
 
 #include "detail/conversion.hpp"
+#include "detail/dec2flt.hpp"
+#include "detail/find.hpp"
 #include "result.hpp"
 
 namespace emio {
@@ -30,6 +32,9 @@ inline constexpr result<bool> parse_sign(reader& in) noexcept;
 template <typename T>
 constexpr result<T> parse_int(reader& in, int base, bool is_negative) noexcept;
 
+template <typename T>
+constexpr result<T> parse_float(reader& in, float_format format) noexcept;
+
 }  // namespace detail
 
 /**
@@ -225,6 +230,26 @@ class reader {
     }
   }
 
+  /**
+   * Parses a floating-point number in fixed or scientific notation from the stream.
+   * Infinity and NaN are accepted as "inf", "infinity" and "nan" (case-insensitive). The result is correctly rounded.
+   * @tparam T The type of the floating-point number. Must be float or double.
+   * @return EOF if the end of the stream has been reached, invalid_data if the char sequence cannot be parsed as
+   * floating-point number or out_of_range if the number is too big for the type.
+   */
+  template <typename T>
+    requires(std::is_same_v<T, float> || std::is_same_v<T, double>)
+  constexpr result<T> parse_float() noexcept {
+    // Store current read position.
+    const char* const backup_it = it_;
+
+    const result<T> res = detail::parse_float<T>(*this, detail::float_format::general);
+    if (!res) {
+      it_ = backup_it;
+    }
+    return res;
+  }
+
   /**
    * Parse options for read_until operations.
    */
@@ -266,7 +291,7 @@ class reader {
    */
   constexpr result<std::string_view> read_until_any_of(
       const std::string_view& group, const read_until_options& options = default_read_until_options()) noexcept {
-    return read_until_pos(view_remaining().find_first_of(group), options);
+    return read_until_match(detail::find_group<true>(it_, end_, group), options);
   }
 
   /**
@@ -278,7 +303,7 @@ class reader {
    */
   constexpr result<std::string_view> read_until_none_of(
       const std::string_view& group, const read_until_options& options = default_read_until_options()) noexcept {
-    return read_until_pos(view_remaining().find_first_not_of(group), options);
+    return read_until_match(detail::find_group<false>(it_, end_, group), options);
   }
 
   /**
@@ -405,12 +430,53 @@ inline constexpr result<bool> parse_sign(reader& in) noexcept {
   return is_negative;
 }
 
+#if !defined(EMIO_OPTIMIZE_FOR_SIZE)
+
+// Converts the absolute value of a parsed integer into the integer type with the same range checks as parse_int.
+template <typename T>
+constexpr result<T> to_checked_int(const uint64_t abs_value, const bool is_negative) noexcept {
+  if constexpr (std::is_unsigned_v<T>) {
+    if (is_negative || abs_value > std::numeric_limits<T>::max()) {
+      return err::out_of_range;
+    }
+    return static_cast<T>(abs_value);
+  } else {
+    const auto max = static_cast<uint64_t>(std::numeric_limits<T>::max());
+    if (is_negative) {
+      if (abs_value > max + 1) {
+        return err::out_of_range;
+      }
+      return static_cast<T>(static_cast<std::make_unsigned_t<T>>(0U - abs_value));
+    }
+    if (abs_value > max) {
+      return err::out_of_range;
+    }
+    return static_cast<T>(abs_value);
+  }
+}
+
+#endif
+
 template <typename T>
 constexpr result<T> parse_int(reader& in, const int base, const bool is_negative) noexcept {
   if (!is_valid_number_base(base)) {
     return err::invalid_argument;
   }
 
+#if !defined(EMIO_OPTIMIZE_FOR_SIZE)
+  // Fast path: validate and convert up to 8 digits at once. Short inputs are faster parsed char by char.
+  if constexpr (is_swar_supported && sizeof(T) <= sizeof(uint64_t)) {
+    if (!EMIO_Z_INTERNAL_IS_CONST_EVAL && (base == 10 || base == 16) && in.cnt_remaining() >= swar_chunk_size) {
+      const char*& it = get_it(in);
+      const std::optional<uint64_t> abs_value =
+          base == 10 ? parse_uint_swar<10>(it, get_end(in)) : parse_uint_swar<16>(it, get_end(in));
+      if (abs_value) {
+        return to_checked_int<T>(*abs_value, is_negative);
+      }
+    }
+  }
+#endif
+
   EMIO_TRY(const char c, in.read_char());
   std::optional<int> digit = char_to_digit(c, base);
   if (!digit) {
@@ -465,6 +531,45 @@ constexpr result<T> parse_int(reader& in, const int base, const bool is_negative
   }
 }
 
+inline constexpr bool parse_special_float(reader& in, std::string_view name) noexcept {
+  const std::string_view remaining = in.view_remaining();
+  if (remaining.size() < name.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < name.size(); i++) {
+    const char c = remaining[i];
+    if (c != name[i] && c != name[i] - ('a' - 'A')) {
+      return false;
+    }
+  }
+  in.pop(name.size());
+  return true;
+}
+
+template <typename T>
+constexpr result<T> parse_float(reader& in, const float_format format) noexcept {
+  EMIO_TRY(const bool is_negative, parse_sign(in));
+  if (in.eof()) {
+    return err::eof;
+  }
+
+  T value{};
+  decimal_t dec{};
+  if (parse_decimal(get_it(in), get_end(in), format, dec)) {
+    value = decimal_to_float<T>(dec);
+    if (value == std::numeric_limits<T>::infinity()) {
+      return err::out_of_range;
+    }
+  } else if (parse_special_float(in, "infinity") || parse_special_float(in, "inf")) {
+    value = std::numeric_limits<T>::infinity();
+  } else if (parse_special_float(in, "nan")) {
+    value = std::numeric_limits<T>::quiet_NaN();
+  } else {
+    return err::invalid_data;
+  }
+  return is_negative ? -value : value;
+}
+
 }  // namespace detail
 
 }  // namespace emio
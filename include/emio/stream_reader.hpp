@@ -0,0 +1,379 @@
+//
+// Copyright (c) 2021 - present, Toni Neubert
+// All rights reserved.
+//
+// For the license information refer to emio.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "reader.hpp"
+#include "scan.hpp"
+
+namespace emio {
+
+/// The default cache size of stream readers.
+inline constexpr size_t default_stream_cache_size{16 * 1024};
+
+/**
+ * This class provides the reader API over an input source which is read in chunks into an internal cache.
+ * Every operation is executed on a reader over the cached input. If the operation requires more input to decide its
+ * result, the cache is refilled and the operation is repeated. Therefore, reads and scans work across chunk boundaries
+ * as long as the lookahead of a single operation fits into the cache.
+ * @note Returned string views point into the cache and are only valid until the next operation.
+ * @note Use a specific subclass for a concrete instantiation.
+ */
+class stream_reader {
+ public:
+  stream_reader(const stream_reader&) = delete;
+  stream_reader(stream_reader&&) = delete;
+  stream_reader& operator=(const stream_reader&) = delete;
+  stream_reader& operator=(stream_reader&&) = delete;
+  virtual ~stream_reader() = default;
+
+  /**
+   * Executes an operation on a reader over the cached input. The cache is refilled and the operation is repeated as
+   * long as the operation fails with EOF or consumes the cached input completely (e.g. an integer could be continued)
+   * and the input source isn't exhausted.
+   * @param func The operation taking a reader and returning a result.
+   * @return The result of the operation or out_of_range if the lookahead doesn't fit into the cache or the error of
+   * the input source. On success, the chars read by the operation are consumed, on failure nothing is consumed.
+   */
+  template <typename Func>
+    requires(std::is_invocable_v<Func, reader&>)
+  std::invoke_result_t<Func, reader&> read_with(const Func& func) noexcept(std::is_nothrow_invocable_v<Func, reader&>) {
+    return read_with_retry(func, [](const auto& res, const reader& rdr) noexcept {
+      return res ? rdr.eof() : res.assume_error() == err::eof;
+    });
+  }
+
+  /**
+   * Checks if the end of the input source has been reached.
+   * @note May refill the cache. A failing input source is treated as end of stream.
+   * @return True if all input has been consumed, otherwise false.
+   */
+  [[nodiscard]] bool eof() noexcept {
+    while (begin_ == end_ && !exhausted_) {
+      if (!refill()) {
+        return true;
+      }
+    }
+    return begin_ == end_;
+  }
+
+  /**
+   * Returns the next char without consuming it.
+   * @return EOF if the end of the stream has been reached.
+   */
+  result<char> peek() noexcept {
+    return read_complete_with([](reader& rdr) noexcept {
+      return rdr.peek();
+    });
+  }
+
+  /**
+   * Reads one char.
+   * @return EOF if the end of the stream has been reached.
+   */
+  result<char> read_char() noexcept {
+    return read_complete_with([](reader& rdr) noexcept {
+      return rdr.read_char();
+    });
+  }
+
+  /**
+   * Reads n chars.
+   * @param n The number of chars to read.
+   * @return EOF if the end of the stream has been reached before reading n chars.
+   */
+  result<std::string_view> read_n_chars(const size_t n) noexcept {
+    return read_complete_with([n](reader& rdr) noexcept {
+      return rdr.read_n_chars(n);
+    });
+  }
+
+  /**
+   * Parses an integer.
+   * @param base The number base of the integer.
+   * @return EOF if the stream is empty, invalid_data if the char sequence cannot be parsed as integer or out_of_range
+   * if the parsed value doesn't fit into the integer type.
+   */
+  template <typename T>
+    requires(std::is_integral_v<T>)
+  result<T> parse_int(const int base = 10) noexcept {
+    return read_with([base](reader& rdr) noexcept {
+      return rdr.parse_int<T>(base);
+    });
+  }
+
+  /**
+   * Reads multiple chars until a given char as delimiter is reached or EOF (configurable).
+   * @param delimiter The char delimiter.
+   * @param options The read until options.
+   * @return invalid_data if the delimiter hasn't been found and ignore_eof is set to true or EOF if the stream is
+   * empty.
+   */
+  result<std::string_view> read_until_char(
+      const char delimiter, const reader::read_until_options& options = reader::read_until_options{}) noexcept {
+    return read_until_with(
+        [&](reader& rdr, const reader::read_until_options& opts) noexcept {
+          return rdr.read_until_char(delimiter, opts);
+        },
+        options);
+  }
+
+  /**
+   * Reads multiple chars until a given char sequence as delimiter is reached or EOF (configurable).
+   * @param delimiter The char sequence.
+   * @param options The read until options.
+   * @return invalid_data if the delimiter hasn't been found and ignore_eof is set to true or EOF if the stream is
+   * empty.
+   */
+  result<std::string_view> read_until_str(
+      const std::string_view& delimiter,
+      const reader::read_until_options& options = reader::read_until_options{}) noexcept {
+    return read_until_with(
+        [&](reader& rdr, const reader::read_until_options& opts) noexcept {
+          return rdr.read_until_str(delimiter, opts);
+        },
+        options);
+  }
+
+  /**
+   * Reads multiple chars until a char of a given group is reached or EOF (configurable).
+   * @param group The char group.
+   * @param options The read until options.
+   * @return invalid_data if no char has been found and ignore_eof is set to True or EOF if the stream is empty.
+   */
+  result<std::string_view> read_until_any_of(
+      const std::string_view& group,
+      const reader::read_until_options& options = reader::read_until_options{}) noexcept {
+    return read_until_with(
+        [&](reader& rdr, const reader::read_until_options& opts) noexcept {
+          return rdr.read_until_any_of(group, opts);
+        },
+        options);
+  }
+
+  /**
+   * Reads multiple chars until no char of a given group is reached or EOF (configurable).
+   * @param group The char group.
+   * @param options The read until options.
+   * @return invalid_data if a char not in the group has been found and ignore_eof is set to True or EOF if the stream
+   * is empty.
+   */
+  result<std::string_view> read_until_none_of(
+      const std::string_view& group,
+      const reader::read_until_options& options = reader::read_until_options{}) noexcept {
+    return read_until_with(
+        [&](reader& rdr, const reader::read_until_options& opts) noexcept {
+          return rdr.read_until_none_of(group, opts);
+        },
+        options);
+  }
+
+  /**
+   * Reads one line. The line break is consumed but not part of the returned line.
+   * @return The line or EOF if the stream is empty.
+   */
+  result<std::string_view> read_line() noexcept {
+    return read_until_char('\n');
+  }
+
+  /**
+   * Reads one char if the char matches the expected one.
+   * @param c The expected char.
+   * @return invalid_data if the chars don't match or EOF if the end of the stream has been reached.
+   */
+  result<char> read_if_match_char(const char c) noexcept {
+    return read_complete_with([c](reader& rdr) noexcept {
+      return rdr.read_if_match_char(c);
+    });
+  }
+
+  /**
+   * Reads multiple chars if the chars match the expected char sequence.
+   * @param sv The expected char sequence.
+   * @return invalid_data if the chars don't match or EOF if the end of the stream has been reached.
+   */
+  result<std::string_view> read_if_match_str(const std::string_view& sv) noexcept {
+    return read_complete_with([&](reader& rdr) noexcept {
+      return rdr.read_if_match_str(sv);
+    });
+  }
+
+ protected:
+  /**
+   * Constructs the stream reader.
+   * @param cache The internal cache to read the input into.
+   */
+  explicit stream_reader(const std::span<char> cache) noexcept
+      : cache_{cache}, begin_{cache.data()}, end_{cache.data()} {}
+
+  /**
+   * Requests more input from a subclass.
+   * @param area The area to read the input into.
+   * @return The number of read chars, zero if the input source is exhausted or eof if reading failed.
+   */
+  virtual result<size_t> request_input(std::span<char> area) noexcept = 0;
+
+ private:
+  // Executes the operation and repeats it with a refilled cache as long as needs_more_input returns true for its
+  // result.
+  template <typename Func, typename NeedsMoreInput>
+  std::invoke_result_t<Func, reader&> read_with_retry(
+      const Func& func, const NeedsMoreInput& needs_more_input) noexcept(std::is_nothrow_invocable_v<Func, reader&>) {
+    while (true) {
+      reader rdr{std::string_view{begin_, end_}};
+      auto res = func(rdr);
+      if (exhausted_ || !needs_more_input(res, rdr)) {
+        if (res) {
+          begin_ += rdr.pos();
+        }
+        return res;
+      }
+      EMIO_TRY(const bool refilled, refill());
+      if (!refilled) {  // The cache is full.
+        return err::out_of_range;
+      }
+    }
+  }
+
+  // Executes an operation whose successful result is final, even if it consumed the cached input completely.
+  template <typename Func>
+  std::invoke_result_t<Func, reader&> read_complete_with(const Func& func) noexcept(
+      std::is_nothrow_invocable_v<Func, reader&>) {
+    return read_with_retry(func, [](const auto& res, const reader& /*rdr*/) noexcept {
+      return !res && res.assume_error() == err::eof;
+    });
+  }
+
+  // Executes a read until operation. The delimiter is searched with ignore_eof set, so that a found delimiter is final
+  // and only a missing one requires more input. Once the input source is exhausted, the given options apply.
+  template <typename Func>
+  result<std::string_view> read_until_with(const Func& func, const reader::read_until_options& options) noexcept {
+    reader::read_until_options search_options{options};
+    search_options.ignore_eof = true;
+    return read_with_retry(
+        [&](reader& rdr) noexcept {
+          return func(rdr, exhausted_ ? options : search_options);
+        },
+        [](const result<std::string_view>& res, const reader& /*rdr*/) noexcept {
+          return !res && (res.assume_error() == err::eof || res.assume_error() == err::invalid_data);
+        });
+  }
+
+  // Moves the remaining input to the front of the cache and reads more input behind it.
+  // Returns false if the cache is full.
+  result<bool> refill() noexcept {
+    if (begin_ != cache_.data()) {
+      end_ = std::copy(begin_, end_, cache_.data());
+      begin_ = cache_.data();
+    }
+    const std::span<char> area{end_, cache_.data() + cache_.size()};
+    if (area.empty()) {
+      return false;
+    }
+    EMIO_TRY(const size_t cnt, request_input(area));
+    if (cnt == 0) {
+      exhausted_ = true;
+    }
+    end_ += cnt;
+    return true;
+  }
+
+  std::span<char> cache_;
+  char* begin_;
+  char* end_;
+  bool exhausted_{};
+};
+
+/**
+ * Scans the content of the stream reader for the given arguments according to the format string.
+ * @param in_rdr The stream reader to scan.
+ * @param format_str The format string.
+ * @param args The arguments which are to be scanned.
+ * @return Success if the scanning was successfully for all arguments. The stream reader may not be empty.
+ */
+template <typename... Args>
+result<void> scan_from(stream_reader& in_rdr, format_scan_string<Args...> format_str, Args&... args) noexcept {
+  return in_rdr.read_with([&](reader& rdr) noexcept {
+    return detail::scan::vscan_from(rdr, make_scan_args(format_str, args...));
+  });
+}
+
+/**
+ * This class fulfills the stream reader API by reading from a file stream.
+ * @tparam CacheSize The size of the internal cache.
+ */
+template <size_t CacheSize = default_stream_cache_size>
+class file_stream_reader final : public stream_reader {
+ public:
+  /**
+   * Constructs and initializes the stream reader with the given file stream.
+   * @param file The file stream.
+   */
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init): cache_ can be left uninitialized
+  explicit file_stream_reader(std::FILE* file) noexcept : stream_reader{cache_}, file_{file} {}
+
+  file_stream_reader(const file_stream_reader&) = delete;
+  file_stream_reader(file_stream_reader&&) = delete;
+  file_stream_reader& operator=(const file_stream_reader&) = delete;
+  file_stream_reader& operator=(file_stream_reader&&) = delete;
+  ~file_stream_reader() override = default;
+
+ protected:
+  result<size_t> request_input(const std::span<char> area) noexcept override {
+    const size_t cnt = std::fread(area.data(), sizeof(char), area.size(), file_);
+    if (cnt == 0 && std::ferror(file_) != 0) {
+      return err::eof;
+    }
+    return cnt;
+  }
+
+ private:
+  std::FILE* file_;
+  std::array<char, CacheSize> cache_;
+};
+
+/**
+ * This class fulfills the stream reader API by reading from a callback.
+ * @tparam Callback The callback type taking a std::span<char> to read into and returning a result<size_t> with the
+ * number of read chars or zero if the input source is exhausted.
+ * @tparam CacheSize The size of the internal cache.
+ */
+template <typename Callback, size_t CacheSize = default_stream_cache_size>
+  requires(std::is_invocable_r_v<result<size_t>, Callback&, std::span<char>>)
+class callback_stream_reader final : public stream_reader {
+ public:
+  /**
+   * Constructs and initializes the stream reader with the given callback.
+   * @param callback The callback.
+   */
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init): cache_ can be left uninitialized
+  explicit callback_stream_reader(Callback callback) noexcept(std::is_nothrow_move_constructible_v<Callback>)
+      : stream_reader{cache_}, callback_{std::move(callback)} {}
+
+  callback_stream_reader(const callback_stream_reader&) = delete;
+  callback_stream_reader(callback_stream_reader&&) = delete;
+  callback_stream_reader& operator=(const callback_stream_reader&) = delete;
+  callback_stream_reader& operator=(callback_stream_reader&&) = delete;
+  ~callback_stream_reader() override = default;
+
+ protected:
+  result<size_t> request_input(const std::span<char> area) noexcept override {
+    return callback_(area);
+  }
+
+ private:
+  Callback callback_;
+  std::array<char, CacheSize> cache_;
+};
+
+}  // namespace emio
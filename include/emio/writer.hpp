@@ -68,7 +68,7 @@ class writer {
    */
   constexpr result<void> write_char_escaped(const char c) noexcept {
     const std::string_view sv(&c, 1);
-    return detail::write_str_escaped(buf_, sv, detail::count_size_when_escaped(sv), '\'');
+    return detail::write_str_escaped(buf_, sv, '\'');
   }
 
   /**
@@ -89,13 +89,27 @@ class writer {
     return success;
   }
 
+  /**
+   * Writes a literal of a format string into the buffer. Buffers supporting it reference the literal instead of
+   * copying it.
+   * @param sv The literal. Must stay valid until the buffer is flushed.
+   * @return EOF if the buffer is to small.
+   */
+  constexpr result<void> write_literal(const std::string_view sv) noexcept {
+    EMIO_TRY(const bool referenced, buf_.try_reference_literal(sv));
+    if (referenced) {
+      return success;
+    }
+    return write_str(sv);
+  }
+
   /**
    * Writes a char sequence escaped into the buffer.
    * @param sv The char sequence.
    * @return EOF if the buffer is to small.
    */
   constexpr result<void> write_str_escaped(const std::string_view sv) noexcept {
-    return detail::write_str_escaped(buf_, sv, detail::count_size_when_escaped(sv), '"');
+    return detail::write_str_escaped(buf_, sv, '"');
   }
 
   /**
@@ -1,13 +1,49 @@
 // Unit under test.
+#include <emio/deferred.hpp>
 #include <emio/format.hpp>
+#include <emio/ranges.hpp>
 
 // Other includes.
 #include <fmt/format.h>
+#include <fmt/ranges.h>
 
 #include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <cinttypes>
 #include <cmath>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+namespace {
+
+size_t allocation_count{};
+
+template <typename Function>
+size_t count_allocations(Function func) {
+  const size_t before = allocation_count;
+  static_cast<void>(func());
+  return allocation_count - before;
+}
+
+}  // namespace
+
+void* operator new(size_t size) {
+  allocation_count++;
+  if (void* ptr = std::malloc(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t /*size*/) noexcept {
+  std::free(ptr);
+}
 
 static constexpr std::string_view long_text{
     "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore "
@@ -110,6 +146,33 @@ TEST_CASE("format string") {
   };
 }
 
+TEST_CASE("format escaped string") {
+  static constexpr std::string_view arg{
+      "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore "
+      "magna aliqua.\n\tUt enim ad minim veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea "
+      "commodo consequat.\n\t\"Duis aute irure dolor in reprehenderit in voluptate velit esse cillum dolore eu fugiat "
+      "nulla pariatur.\"\n"};
+
+  BENCHMARK("base") {
+    const std::string emio_str = emio::format("{:?}", arg);
+    const std::string fmt_str = fmt::format("{:?}", arg);
+    REQUIRE(emio_str == fmt_str);
+    return emio_str == fmt_str;
+  };
+  BENCHMARK("emio") {
+    return emio::format("{:?}", arg);
+  };
+  BENCHMARK("emio runtime") {
+    return emio::format(emio::runtime("{:?}"), arg);
+  };
+  BENCHMARK("fmt") {
+    return fmt::format("{:?}", arg);
+  };
+  BENCHMARK("fmt runtime") {
+    return fmt::format(fmt::runtime("{:?}"), arg);
+  };
+}
+
 TEST_CASE("format small integer") {
   static constexpr std::string_view format_str{" {}"};
   static constexpr int arg = 1;
@@ -236,6 +299,13 @@ TEST_CASE("format complex format spec") {
   BENCHMARK("emio runtime") {
     return emio::format_to(buf.data(), emio::runtime(format_str), arg).value();
   };
+  const auto compiled = emio::compiled_format<int64_t>::from(format_str).value();
+  BENCHMARK("emio compiled") {
+    return emio::format_to(buf.data(), compiled, arg).value();
+  };
+  BENCHMARK("emio compile-time compiled") {
+    return emio::format_to(buf.data(), emio::compile<"{0:x^+#20X}">, arg).value();
+  };
   BENCHMARK("fmt") {
     return fmt::format_to(buf.data(), format_str, arg);
   };
@@ -382,6 +452,84 @@ TEST_CASE("format double fixed") {
   };
 }
 
+TEST_CASE("format double hex") {
+  static constexpr std::string_view format_str{"{:a}"};
+  static constexpr double arg = M_PI;
+
+  constexpr size_t emio_formatted_size = emio::formatted_size(format_str, arg);
+  const size_t fmt_formatted_size = fmt::formatted_size(format_str, arg);
+  REQUIRE(emio_formatted_size == fmt_formatted_size);
+  std::array<char, 2 * emio_formatted_size> buf{};
+
+  BENCHMARK("base") {
+    const std::string emio_str = emio::format(format_str, arg);
+    const std::string fmt_str = fmt::format(format_str, arg);
+    REQUIRE(emio_str == fmt_str);
+
+    REQUIRE(snprintf(buf.data(), buf.size(), "%a", arg) == static_cast<int>(emio_str.size()));
+    REQUIRE(emio_str == buf.data());
+
+    return emio_str == fmt_str;
+  };
+  BENCHMARK("emio") {
+    return emio::format_to(buf.data(), format_str, arg);
+  };
+  BENCHMARK("emio runtime") {
+    return emio::format_to(buf.data(), emio::runtime(format_str), arg).value();
+  };
+  BENCHMARK("fmt") {
+    return fmt::format_to(buf.data(), format_str, arg);
+  };
+  BENCHMARK("fmt runtime") {
+    return fmt::format_to(buf.data(), fmt::runtime(format_str), arg);
+  };
+  BENCHMARK("snprintf") {
+    return snprintf(buf.data(), buf.size(), "%a", arg);
+  };
+}
+
+TEST_CASE("format double with high precision") {
+  static constexpr std::string_view format_str{"{:.500f}"};
+  static constexpr double arg = M_PI;
+
+  std::array<char, 1024> buf{};
+
+  BENCHMARK("base") {
+    const std::string emio_str = emio::format(format_str, arg);
+    const std::string fmt_str = fmt::format(format_str, arg);
+    REQUIRE(emio_str == fmt_str);
+
+    REQUIRE(snprintf(buf.data(), buf.size(), "%.500f", arg) == static_cast<int>(emio_str.size()));
+    REQUIRE(emio_str == buf.data());
+
+    return emio_str == fmt_str;
+  };
+
+  // The digits are generated on the stack.
+  CHECK(count_allocations([&] {
+          return emio::format_to(buf.data(), format_str, arg);
+        }) == 0);
+  CHECK(count_allocations([&] {
+          return emio::format_to(buf.data(), emio::runtime(format_str), arg).value();
+        }) == 0);
+
+  BENCHMARK("emio") {
+    return emio::format_to(buf.data(), format_str, arg);
+  };
+  BENCHMARK("emio runtime") {
+    return emio::format_to(buf.data(), emio::runtime(format_str), arg).value();
+  };
+  BENCHMARK("fmt") {
+    return fmt::format_to(buf.data(), format_str, arg);
+  };
+  BENCHMARK("fmt runtime") {
+    return fmt::format_to(buf.data(), fmt::runtime(format_str), arg);
+  };
+  BENCHMARK("snprintf") {
+    return snprintf(buf.data(), buf.size(), "%.500f", arg);
+  };
+}
+
 TEST_CASE("format many arguments") {
   static constexpr std::string_view format_str{"{} {} {} {} {} {} {} {} {} {}"};
   // No floating-point because this shifts this benchmark result too much because it is much slower in emio than in fmt.
@@ -406,6 +554,15 @@ TEST_CASE("format many arguments") {
   BENCHMARK("emio runtime") {
     return emio::format_to(buf.data(), emio::runtime(format_str), ARGS).value();
   };
+  const auto compiled = emio::compiled_format<bool, int8_t, uint8_t, int16_t, uint16_t, int32_t, uint32_t, const char*,
+                                              char, std::nullptr_t>::from(format_str)
+                            .value();
+  BENCHMARK("emio compiled") {
+    return emio::format_to(buf.data(), compiled, ARGS).value();
+  };
+  BENCHMARK("emio compile-time compiled") {
+    return emio::format_to(buf.data(), emio::compile<"{} {} {} {} {} {} {} {} {} {}">, ARGS).value();
+  };
   BENCHMARK("fmt") {
     return fmt::format_to(buf.data(), format_str, ARGS);
   };
@@ -413,3 +570,158 @@ TEST_CASE("format many arguments") {
     return fmt::format_to(buf.data(), fmt::runtime(format_str), ARGS);
   };
 }
+
+TEST_CASE("format args dispatch") {
+  // Compares the dispatch of the type erased format args: tagged union for core types vs. virtual call.
+  using tagged_arg = emio::detail::format::tagged_format_arg;
+  using virtual_arg = emio::detail::arg<emio::writer, emio::detail::format::format_arg_trait>;
+
+  static constexpr bool b = true;
+  static constexpr int32_t i32 = -42;
+  static constexpr int64_t i64 = 8978612134175239201;
+  static constexpr double d = 42.24;
+  static constexpr std::string_view sv = "abc";
+
+  const std::array<tagged_arg, 5> tagged_args{tagged_arg{b}, tagged_arg{i32}, tagged_arg{i64}, tagged_arg{d},
+                                              tagged_arg{sv}};
+  const std::array<virtual_arg, 5> virtual_args{virtual_arg{b}, virtual_arg{i32}, virtual_arg{i64}, virtual_arg{d},
+                                                virtual_arg{sv}};
+  std::array<char, 128> buf{};
+
+  const auto dispatch = [&](const auto& args) {
+    emio::span_buffer span_buf{buf};
+    emio::writer wtr{span_buf};
+    for (const auto& arg : args) {
+      emio::reader format_rdr{"}"};
+      arg.process_arg(wtr, format_rdr).value();
+    }
+    return span_buf.view().size();
+  };
+
+  BENCHMARK("base") {
+    const size_t tagged_size = dispatch(tagged_args);
+    const size_t virtual_size = dispatch(virtual_args);
+    REQUIRE(tagged_size == virtual_size);
+    return tagged_size == virtual_size;
+  };
+  BENCHMARK("tagged union") {
+    return dispatch(tagged_args);
+  };
+  BENCHMARK("virtual") {
+    return dispatch(virtual_args);
+  };
+}
+
+TEST_CASE("defer format") {
+  // Compares the cost of the producer: formatting a log line vs. capturing its arguments into a binary record.
+  static constexpr std::string_view format_str{"{} [{}] request {} from {} took {:.3f} ms"};
+#define LOG_ARGS                                                                                         \
+  static_cast<uint64_t>(1700000000123), 'I', static_cast<uint32_t>(4711), std::string_view{"10.0.0.1"}, 12.3456
+
+  std::array<char, 256> buf{};
+
+  BENCHMARK("base") {
+    emio::span_buffer records{buf};
+    REQUIRE(emio::defer_to(records, format_str, LOG_ARGS));
+    emio::memory_buffer out;
+    REQUIRE(emio::format_deferred_to(out, records.view()).value() == records.view().size());
+    REQUIRE(out.view() == emio::format(format_str, LOG_ARGS));
+    return out.view().size();
+  };
+  BENCHMARK("emio format_to") {
+    return emio::format_to(buf.data(), format_str, LOG_ARGS).value();
+  };
+  BENCHMARK("emio defer_to") {
+    emio::span_buffer records{buf};
+    return emio::defer_to(records, format_str, LOG_ARGS);
+  };
+  BENCHMARK("emio format_deferred_to") {
+    emio::span_buffer records{buf};
+    emio::defer_to(records, format_str, LOG_ARGS).value();
+    std::array<char, 256> out_buf{};
+    emio::span_buffer out{out_buf};
+    return emio::format_deferred_to(out, records.view()).value();
+  };
+#undef LOG_ARGS
+}
+
+TEST_CASE("format range of integers") {
+  std::vector<int32_t> values(1000);
+  for (size_t i = 0; i < values.size(); i++) {
+    values[i] = static_cast<int32_t>(i * 7919 % 100'000) - 50'000;
+  }
+
+  BENCHMARK("base") {
+    const std::string emio_str = emio::format("{}", values);
+    const std::string fmt_str = fmt::format("{}", values);
+    REQUIRE(emio_str == fmt_str);
+    return emio_str == fmt_str;
+  };
+  BENCHMARK("emio") {
+    return emio::format("{}", values);
+  };
+  BENCHMARK("fmt") {
+    return fmt::format("{}", values);
+  };
+}
+
+TEST_CASE("format range of doubles") {
+  std::vector<double> values(1000);
+  for (size_t i = 0; i < values.size(); i++) {
+    values[i] = static_cast<double>(i) * 0.25 - 100.0 + 1.0 / 3;
+  }
+
+  BENCHMARK("base") {
+    const std::string emio_str = emio::format("{}", values);
+    const std::string fmt_str = fmt::format("{}", values);
+    REQUIRE(emio_str == fmt_str);
+    return emio_str == fmt_str;
+  };
+  BENCHMARK("emio") {
+    return emio::format("{}", values);
+  };
+  BENCHMARK("fmt") {
+    return fmt::format("{}", values);
+  };
+}
+
+TEST_CASE("format into memory buffers of a request") {
+  // Compares formatting many strings, which are kept until the end of a request, into memory_buffers which allocate
+  // from the heap vs. from a monotonic arena which is released at once at the end of the request.
+  constexpr size_t format_cnt = 1000;
+  std::vector<char> arena_storage(4 * 1024 * 1024);
+
+  const auto heap_request = [] {
+    std::vector<emio::memory_buffer<>> bufs;
+    bufs.reserve(format_cnt);
+    size_t total = 0;
+    for (size_t i = 0; i < format_cnt; i++) {
+      emio::memory_buffer<>& buf = bufs.emplace_back();
+      emio::format_to(buf, "{}: {}", i, long_text).value();
+      total += buf.view().size();
+    }
+    return total;
+  };
+  const auto arena_request = [&] {
+    std::pmr::monotonic_buffer_resource arena{arena_storage.data(), arena_storage.size()};
+    std::pmr::vector<emio::pmr::memory_buffer<>> bufs{&arena};
+    bufs.reserve(format_cnt);
+    size_t total = 0;
+    for (size_t i = 0; i < format_cnt; i++) {
+      emio::pmr::memory_buffer<>& buf = bufs.emplace_back();  // Allocates from the arena.
+      emio::format_to(buf, "{}: {}", i, long_text).value();
+      total += buf.view().size();
+    }
+    return total;
+  };
+
+  CHECK(heap_request() == arena_request());
+  CHECK(count_allocations(arena_request) == 0);
+
+  BENCHMARK("emio memory_buffer") {
+    return heap_request();
+  };
+  BENCHMARK("emio pmr::memory_buffer") {
+    return arena_request();
+  };
+}
@@ -0,0 +1,107 @@
+// Unit under test.
+#include <emio/format.hpp>
+#include <emio/os.hpp>
+
+// Other includes.
+#include <fcntl.h>
+
+#include <atomic>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int records_per_producer = 1000;
+
+// Runs the function in the given number of producer threads and waits for them.
+template <typename Function>
+void run_producers(const int producer_cnt, const Function& func) {
+  std::vector<std::thread> producers;
+  producers.reserve(static_cast<size_t>(producer_cnt));
+  for (int p = 0; p < producer_cnt; p++) {
+    producers.emplace_back(func, p);
+  }
+  for (std::thread& producer : producers) {
+    producer.join();
+  }
+}
+
+}  // namespace
+
+TEST_CASE("print from multiple threads") {
+  // Compares the throughput of formatting log lines from a scaling number of producer threads into a std::FILE (which
+  // locks the stream for each line) vs. into a ring_buffer_sink drained by one consumer thread.
+  std::FILE* file = std::fopen("/dev/null", "w");
+  REQUIRE(file);
+  const int fd = ::open("/dev/null", O_WRONLY);
+  REQUIRE(fd >= 0);
+
+  for (const int producer_cnt : {1, 2, 4, 8, 32}) {
+    BENCHMARK("emio print_atomic to std::FILE (" + std::to_string(producer_cnt) + " producers)") {
+      run_producers(producer_cnt, [&](const int p) {
+        for (int i = 0; i < records_per_producer; i++) {
+          emio::print_atomic(file, "producer {} record {} value {}\n", p, i, 0.5 * i).value();
+        }
+      });
+    };
+
+    BENCHMARK("emio ring_buffer_sink (" + std::to_string(producer_cnt) + " producers)") {
+      const auto ring = std::make_unique<emio::ring_buffer_sink<>>();
+      std::atomic<bool> producing{true};
+      std::thread consumer{[&] {
+        while (producing.load(std::memory_order_relaxed)) {
+          if (ring->drain_to(fd).value() == 0) {
+            std::this_thread::yield();
+          }
+        }
+        ring->drain_to(fd).value();
+      }};
+      run_producers(producer_cnt, [&](const int p) {
+        for (int i = 0; i < records_per_producer; i++) {
+          auto slot = ring->reserve();
+          emio::format_to(slot, "producer {} record {} value {}\n", p, i, 0.5 * i).value();
+        }
+      });
+      producing.store(false, std::memory_order_relaxed);
+      consumer.join();
+    };
+  }
+
+  ::close(fd);
+  std::fclose(file);
+}
+
+TEST_CASE("format into a file") {
+  // Compares formatting trace records into a temporary file with fd_buffer (which writes on the formatting thread) vs.
+  // async_fd_buffer (which writes on a background thread).
+  constexpr int record_cnt = 10000;
+
+  std::FILE* tmpf = std::tmpfile();
+  REQUIRE(tmpf);
+  const int fd = fileno(tmpf);
+
+  BENCHMARK("emio fd_buffer") {
+    REQUIRE(::ftruncate(fd, 0) == 0);
+    emio::fd_buffer buf{fd};
+    for (int i = 0; i < record_cnt; i++) {
+      emio::format_to(buf, "trace {} value {} state {}\n", i, 0.5 * i, "running").value();
+    }
+    return buf.flush();
+  };
+
+  BENCHMARK("emio async_fd_buffer") {
+    REQUIRE(::ftruncate(fd, 0) == 0);
+    const auto buf = std::make_unique<emio::async_fd_buffer<>>(fd);
+    for (int i = 0; i < record_cnt; i++) {
+      emio::format_to(*buf, "trace {} value {} state {}\n", i, 0.5 * i, "running").value();
+    }
+    return buf->flush();
+  };
+
+  std::fclose(tmpf);
+}
@@ -99,3 +99,126 @@ TEST_CASE("scan complex hex") {
     return sscanf(input.data(), "%" PRIx64, &i);
   };
 }
+
+TEST_CASE("scan double") {
+  static constexpr std::string_view input("3.141592653589793");
+
+  BENCHMARK("base") {
+    double d;
+    REQUIRE(emio::scan(input, "{}", d));
+    REQUIRE(d == M_PI);
+    d = 0;
+    REQUIRE(sscanf(input.data(), "%lf", &d) == 1);
+    REQUIRE(d == M_PI);
+    REQUIRE(strtod(input.data(), nullptr) == M_PI);
+  };
+  BENCHMARK("emio") {
+    double d;
+    return emio::scan(input, "{}", d);
+  };
+  BENCHMARK("emio runtime") {
+    double d;
+    return emio::scan(input, emio::runtime("{}"), d);
+  };
+  BENCHMARK("emio reader") {
+    return emio::reader{input}.parse_float<double>();
+  };
+  BENCHMARK("strtod") {
+    return strtod(input.data(), nullptr);
+  };
+  BENCHMARK("snprintf") {
+    double d;
+    return sscanf(input.data(), "%lf", &d);
+  };
+}
+
+TEST_CASE("scan double with exponent") {
+  static constexpr std::string_view input("-6.02214076e-23");
+
+  BENCHMARK("base") {
+    double d;
+    REQUIRE(emio::scan(input, "{}", d));
+    REQUIRE(d == -6.02214076e-23);
+    d = 0;
+    REQUIRE(sscanf(input.data(), "%lf", &d) == 1);
+    REQUIRE(d == -6.02214076e-23);
+    REQUIRE(strtod(input.data(), nullptr) == -6.02214076e-23);
+  };
+  BENCHMARK("emio") {
+    double d;
+    return emio::scan(input, "{}", d);
+  };
+  BENCHMARK("emio runtime") {
+    double d;
+    return emio::scan(input, emio::runtime("{}"), d);
+  };
+  BENCHMARK("emio reader") {
+    return emio::reader{input}.parse_float<double>();
+  };
+  BENCHMARK("strtod") {
+    return strtod(input.data(), nullptr);
+  };
+  BENCHMARK("snprintf") {
+    double d;
+    return sscanf(input.data(), "%lf", &d);
+  };
+}
+
+TEST_CASE("scan double with many digits") {
+  // More than 19 significant digits near a halfway point: requires the big integer fallback.
+  static constexpr std::string_view input("1.00000000000000011102230246251565404236316680908203125");
+
+  BENCHMARK("base") {
+    double d;
+    REQUIRE(emio::scan(input, "{}", d));
+    REQUIRE(d == 1.0);
+    d = 0;
+    REQUIRE(sscanf(input.data(), "%lf", &d) == 1);
+    REQUIRE(d == 1.0);
+    REQUIRE(strtod(input.data(), nullptr) == 1.0);
+  };
+  BENCHMARK("emio") {
+    double d;
+    return emio::scan(input, "{}", d);
+  };
+  BENCHMARK("emio runtime") {
+    double d;
+    return emio::scan(input, emio::runtime("{}"), d);
+  };
+  BENCHMARK("emio reader") {
+    return emio::reader{input}.parse_float<double>();
+  };
+  BENCHMARK("strtod") {
+    return strtod(input.data(), nullptr);
+  };
+  BENCHMARK("snprintf") {
+    double d;
+    return sscanf(input.data(), "%lf", &d);
+  };
+}
+
+TEST_CASE("read until any of") {
+  static constexpr std::string_view input(
+      "timestamp=2023-01-01T00:00:00.000Z host=server-with-a-rather-long-name.example.com level=info "
+      "message=\"the quick brown fox jumps over the lazy dog\";");
+
+  BENCHMARK("base") {
+    emio::reader rdr{input};
+    REQUIRE(rdr.read_until_any_of(";\"") == input.substr(0, input.find_first_of(";\"")));
+    REQUIRE(rdr.read_until_none_of("abcdefghijklmnopqrstuvwxyz ") == "the quick brown fox jumps over the lazy dog");
+  };
+  BENCHMARK("emio reader any of") {
+    emio::reader rdr{input};
+    return rdr.read_until_any_of(";\"");
+  };
+  BENCHMARK("std::string_view::find_first_of") {
+    return input.find_first_of(";\"");
+  };
+  BENCHMARK("emio reader none of") {
+    emio::reader rdr{input};
+    return rdr.read_until_none_of("abcdefghijklmnopqrstuvwxyz0123456789 =-.:");
+  };
+  BENCHMARK("std::string_view::find_first_not_of") {
+    return input.find_first_not_of("abcdefghijklmnopqrstuvwxyz0123456789 =-.:");
+  };
+}
@@ -2,6 +2,7 @@
 
 #include "emio/detail/format/decode.hpp"
 #include "emio/detail/format/dragon.hpp"
+#include "emio/detail/format/grisu.hpp"
 
 extern "C" {
 #include <unistd.h>
@@ -85,6 +86,32 @@ void test_shortest(double d) {
   rust_free(b);
 }
 
+void test_shortest_grisu(double d) {
+  auto full_decoded = emio::detail::format::decode(d);
+  if (full_decoded.category != emio::detail::format::category::finite) {
+    return;
+  }
+
+  std::array<char, std::numeric_limits<double>::max_digits10> buf{};
+  auto res = emio::detail::format::format_shortest_opt(full_decoded.finite, buf);
+  if (!res) {
+    return;  // Falls back to Dragon4 which is checked by test_shortest.
+  }
+
+  Buffer b = rust_shortest(d);
+  int16_t rust_k = b.k;
+  std::span<const char> rust_digits{reinterpret_cast<const char*>(b.data), b.len};
+
+  auto [digits, k] = *res;
+  if (!std::equal(rust_digits.begin(), rust_digits.end(), digits.begin(), digits.end()) || rust_k != k) {
+    print_shortest_header(d);
+    print_result("rust", rust_digits, rust_k);
+    print_result("emio (grisu)", digits, k);
+    abort();
+  }
+  rust_free(b);
+}
+
 void test_fixed(double d, int16_t precision) {
   precision = std::clamp<int16_t>(precision, -1000, 1000);
 
@@ -149,6 +176,39 @@ void test_exact(double d, int16_t precision) {
   rust_free(b);
 }
 
+void test_exact_grisu(double d, int16_t precision, emio::detail::format::format_exact_mode mode) {
+  auto full_decoded = emio::detail::format::decode(d);
+  if (full_decoded.category != emio::detail::format::category::finite) {
+    return;
+  }
+
+  std::array<char, emio::detail::format::grisu_exact_max_digits> buf{};
+  auto res = emio::detail::format::format_exact_opt(full_decoded.finite, buf, mode, precision);
+  if (!res) {
+    return;  // Falls back to Dragon4 which is checked by test_fixed and test_exact.
+  }
+
+  const bool fixed = mode == emio::detail::format::format_exact_mode::decimal_point;
+  Buffer b = fixed ? rust_fixed(d, precision) : rust_exponent(d, precision);
+  int16_t rust_k = b.k;
+  std::span<const char> rust_digits{reinterpret_cast<const char*>(b.data), b.len};
+  rust_digits = remove_trailing_zeros(rust_digits);
+
+  auto [digits, k] = *res;
+  digits = remove_trailing_zeros(digits);
+  if (!std::equal(rust_digits.begin(), rust_digits.end(), digits.begin(), digits.end()) || rust_k != k) {
+    if (fixed) {
+      print_fixed_header(d, precision);
+    } else {
+      print_exact_header(d, precision);
+    }
+    print_result("rust", rust_digits, rust_k);
+    print_result("emio (grisu)", digits, k);
+    abort();
+  }
+  rust_free(b);
+}
+
 }  // namespace
 
 __AFL_FUZZ_INIT();
@@ -163,6 +223,7 @@ int main() {
 
     double d = *magic;
     test_shortest(d);
+    test_shortest_grisu(d);
 
     int16_t limit = 17;
     if (len >= (sizeof(double) + sizeof(int16_t))) {
@@ -170,6 +231,10 @@ int main() {
     }
     test_fixed(d, limit);
     test_exact(d, limit);
+    test_exact_grisu(d, std::clamp<int16_t>(limit, 0, 1000),
+                     emio::detail::format::format_exact_mode::decimal_point);
+    test_exact_grisu(d, std::clamp<int16_t>(limit, 1, 1000),
+                     emio::detail::format::format_exact_mode::significand_digits);
   }
 
   return 0;
@@ -2,8 +2,10 @@
 #include <emio/detail/conversion.hpp>
 
 // Other includes.
+#include <array>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators_range.hpp>
+#include <string>
 
 // TODO: More conversion tests
 
@@ -61,6 +63,8 @@ TEST_CASE("char_to_digit") {
     CHECK(!char_to_digit('\x10', 10));
     CHECK(!char_to_digit('/', 10));
     CHECK(!char_to_digit(':', 10));
+    CHECK(!char_to_digit(':', 16));
+    CHECK(!char_to_digit('@', 36));
     CHECK(char_to_digit('9', 10) == 9);
     CHECK(!char_to_digit('A', 10));
     CHECK(!char_to_digit('a', 10));
@@ -86,3 +90,40 @@ TEST_CASE("char_to_digit") {
     CHECK(!char_to_digit(std::numeric_limits<char>::max(), 36));
   }
 }
+
+TEST_CASE("count_digits_10 and write_decimal") {
+  // Test strategy:
+  // * Count and write the digits of numbers around each power of ten and the limits of the integer types.
+  // Expected: The number of digits and the written digits match std::to_string.
+
+  using emio::detail::count_digits_10;
+  using emio::detail::write_decimal;
+
+  const auto check = [](auto number) {
+    const std::string expected = std::to_string(number);
+    std::array<char, 32> buf{};
+    const char* const end = buf.data() + buf.size();
+    const char* const begin = write_decimal(number, buf.data() + buf.size());
+    CHECK(count_digits_10(number) == expected.size());
+    CHECK(std::string_view{begin, end} == expected);
+  };
+
+  uint64_t power{1};
+  for (size_t i = 0; i < 20; i++) {
+    check(power - 1);
+    check(power);
+    check(power + 1);
+    if (power <= std::numeric_limits<uint32_t>::max()) {
+      check(static_cast<uint32_t>(power - 1));
+      check(static_cast<uint32_t>(power));
+    }
+    power *= 10;
+  }
+  check(std::numeric_limits<uint32_t>::max());
+  check(std::numeric_limits<uint64_t>::max());
+  check(uint64_t{12'345'678'901'234'567'890U});
+
+  STATIC_CHECK(count_digits_10(99'999U) == 5);
+  STATIC_CHECK(count_digits_10(100'000U) == 6);
+  STATIC_CHECK(count_digits_10(std::numeric_limits<uint64_t>::max()) == 20);
+}
@@ -60,6 +60,13 @@ void check_gang_of_5(T& buf) {
     buf2 = std::move(buf_tmp);
     check_equality_of_vector(buf, buf2);
   }
+  SECTION("move-assign into external storage") {
+    T buf_tmp{buf};
+    T buf2;
+    buf2.reserve(1024);
+    buf2 = std::move(buf_tmp);
+    check_equality_of_vector(buf, buf2);
+  }
   SECTION("wild") {
     T buf2{buf};
     T buf3{std::move(buf2)};
@@ -0,0 +1,153 @@
+// Unit under test.
+#include "emio/detail/dec2flt.hpp"
+
+// Other includes.
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+
+#include "catch2/catch_test_macros.hpp"
+
+namespace {
+
+template <typename T>
+T to_float(std::string_view str) {
+  emio::detail::decimal_t dec{};
+  const char* it = str.data();
+  REQUIRE(emio::detail::parse_decimal(it, str.data() + str.size(), emio::detail::float_format::general, dec));
+  REQUIRE(it == str.data() + str.size());
+  return emio::detail::decimal_to_float<T>(dec);
+}
+
+}  // namespace
+
+TEST_CASE("parse_decimal") {
+  using emio::detail::float_format;
+
+  const auto parse = [](std::string_view str, float_format format = float_format::general) {
+    emio::detail::decimal_t dec{};
+    const char* it = str.data();
+    const bool res = emio::detail::parse_decimal(it, str.data() + str.size(), format, dec);
+    return std::tuple{res, dec, static_cast<size_t>(it - str.data())};
+  };
+
+  SECTION("mantissa and exponent") {
+    const auto [res, dec, len] = parse("0012.3400e2");
+    CHECK(res);
+    CHECK(len == 11);
+    CHECK(dec.mantissa == 123400);
+    CHECK(dec.exponent == -2);
+    CHECK(!dec.truncated);
+    CHECK(dec.integral == "0012");
+    CHECK(dec.fraction == "3400");
+    CHECK(dec.digits_exponent == -2);
+  }
+  SECTION("leading zeros of the fraction are not significant") {
+    const auto [res, dec, len] = parse("0.000000000000000000001234567890123456789");
+    CHECK(res);
+    CHECK(dec.mantissa == 1234567890123456789);
+    CHECK(dec.exponent == -39);
+    CHECK(!dec.truncated);
+  }
+  SECTION("truncated") {
+    const auto [res, dec, len] = parse("12345678901234567890123");
+    CHECK(res);
+    CHECK(dec.mantissa == 1234567890123456789);
+    CHECK(dec.exponent == 4);
+    CHECK(dec.truncated);
+
+    CHECK(!std::get<1>(parse("12345678901234567890000")).truncated);
+  }
+  SECTION("format") {
+    CHECK(std::get<2>(parse("1e5", float_format::fixed)) == 1);
+    CHECK(std::get<2>(parse("1e5", float_format::scientific)) == 3);
+    CHECK(!std::get<0>(parse("1", float_format::scientific)));
+    CHECK(!std::get<0>(parse("1e+", float_format::scientific)));
+    CHECK(std::get<2>(parse("1e+", float_format::general)) == 1);
+  }
+  SECTION("invalid") {
+    CHECK(!std::get<0>(parse("")));
+    CHECK(!std::get<0>(parse(".")));
+    CHECK(!std::get<0>(parse("e1")));
+    CHECK(!std::get<0>(parse("-1")));
+  }
+}
+
+TEST_CASE("get_pow10_128") {
+  // Check the approximation against the value of 10^k (compared in log10 space to cover the full range).
+  for (int64_t k = emio::detail::pow10_128_first; k <= 308; k++) {
+    const emio::detail::pow10_128_t p = emio::detail::get_pow10_128(k);
+    INFO(k);
+    REQUIRE((p.hi >> 63) == 1);
+    const double log10_approx = std::log10(static_cast<double>(p.hi)) + (p.e + 64) * std::log10(2.0);
+    CHECK(std::abs(log10_approx - static_cast<double>(k)) < 1e-12);
+  }
+  const emio::detail::pow10_128_t p = emio::detail::get_pow10_128(27);
+  CHECK(p.hi == 0xcecb8f27f4200f3a);
+  CHECK(p.lo == 0x0000000000000000);
+  CHECK(p.e == -38);
+}
+
+TEST_CASE("decimal_to_float") {
+  SECTION("double") {
+    CHECK(to_float<double>("0") == 0.0);
+    CHECK(to_float<double>("1") == 1.0);
+    CHECK(to_float<double>("0.1") == 0.1);
+    CHECK(to_float<double>("1e23") == 1e23);
+    CHECK(to_float<double>("8.98846567431158e307") == 8.98846567431158e307);
+    CHECK(to_float<double>("1.7976931348623157e308") == std::numeric_limits<double>::max());
+    CHECK(to_float<double>("1.7976931348623159e308") == std::numeric_limits<double>::infinity());
+    CHECK(to_float<double>("2.2250738585072011e-308") == 2.2250738585072011e-308);
+    CHECK(to_float<double>("4.9406564584124654e-324") == std::numeric_limits<double>::denorm_min());
+    CHECK(to_float<double>("1e-324") == 0.0);
+  }
+  SECTION("float") {
+    CHECK(to_float<float>("0.1") == 0.1F);
+    CHECK(to_float<float>("16777217") == 16777216.0F);
+    CHECK(to_float<float>("16777219") == 16777220.0F);
+    CHECK(to_float<float>("3.4028235e38") == std::numeric_limits<float>::max());
+    CHECK(to_float<float>("3.4028236e38") == std::numeric_limits<float>::infinity());
+    CHECK(to_float<float>("1.4e-45") == std::numeric_limits<float>::denorm_min());
+    CHECK(to_float<float>("7e-46") == 0.0F);
+  }
+  SECTION("compile-time") {
+    STATIC_CHECK([] {
+      emio::detail::decimal_t dec{};
+      const std::string_view str{"2.718281828459045235360287"};
+      const char* it = str.data();
+      return emio::detail::parse_decimal(it, str.data() + str.size(), emio::detail::float_format::general, dec) &&
+             emio::detail::decimal_to_float<double>(dec) == 2.718281828459045;
+    }());
+  }
+}
+
+TEST_CASE("decimal_to_float halfway cases") {
+  // The exact decimal representation of the halfway point between two doubles needs the slow path.
+  if (std::numeric_limits<long double>::digits <= std::numeric_limits<double>::digits) {
+    return;  // The halfway point cannot be computed.
+  }
+  std::mt19937_64 gen{42};  // NOLINT(cert-msc32-c,cert-msc51-cpp): deterministic on purpose
+  std::string str(1200, '\0');
+  for (size_t i = 0; i < 2'000; i++) {
+    const double d = std::abs(std::bit_cast<double>(gen() >> 1));
+    const double next = std::nextafter(d, std::numeric_limits<double>::infinity());
+    if (!std::isfinite(next)) {
+      continue;
+    }
+    const long double halfway = (static_cast<long double>(d) + static_cast<long double>(next)) / 2;
+    const int len = std::snprintf(str.data(), str.size(), "%.1100Le", halfway);
+    REQUIRE(len > 0);
+    const std::string_view halfway_str{str.data(), static_cast<size_t>(len)};
+    INFO(halfway_str);
+
+    const double even = (std::bit_cast<uint64_t>(d) & 1) == 0 ? d : next;
+    CHECK(to_float<double>(halfway_str) == even);
+
+    // Slightly above the halfway point.
+    std::string above{halfway_str};
+    above.insert(above.find('e'), "1");
+    CHECK(to_float<double>(above) == next);
+  }
+}
@@ -0,0 +1,62 @@
+// Unit under test.
+#include <emio/detail/find.hpp>
+
+// Other includes.
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <string>
+
+namespace {
+
+template <bool Match>
+size_t find_group(std::string_view input, std::string_view group) {
+  return static_cast<size_t>(emio::detail::find_group<Match>(input.data(), input.data() + input.size(), group) -
+                             input.data());
+}
+
+size_t expected_find_first_of(std::string_view input, std::string_view group) {
+  return std::min(input.find_first_of(group), input.size());
+}
+
+size_t expected_find_first_not_of(std::string_view input, std::string_view group) {
+  return std::min(input.find_first_not_of(group), input.size());
+}
+
+}  // namespace
+
+TEST_CASE("find_group", "[find]") {
+  // Test strategy:
+  // * Search for each position in inputs of different lengths with groups of different sizes (covering the scalar,
+  //   SIMD and lookup table paths).
+  // Expected: The results are the same as with std::string_view::find_first_of/find_first_not_of.
+
+  const std::string_view group =
+      GENERATE("", ",", "{}", "\"\\", ";,\t ", "abcdefgh", "abcdefghi", "0123456789\x80\xff");
+  INFO("group: " << group);
+
+  for (size_t len = 0; len <= 70; len++) {
+    std::string filler(len, 'x');
+    CHECK(find_group<true>(filler, group) == expected_find_first_of(filler, group));
+    CHECK(find_group<false>(filler, group) == expected_find_first_not_of(filler, group));
+
+    for (const char c : group) {
+      for (size_t pos = 0; pos < len; pos++) {
+        std::string input = filler;
+        input[pos] = c;
+        INFO("len: " << len << ", pos: " << pos);
+        CHECK(find_group<true>(input, group) == expected_find_first_of(input, group));
+
+        std::string inverse(len, c);
+        inverse[pos] = 'x';
+        CHECK(find_group<false>(inverse, group) == expected_find_first_not_of(inverse, group));
+      }
+    }
+  }
+}
+
+TEST_CASE("find_group at compile-time", "[find]") {
+  constexpr std::string_view input = "key=value;other=1234567890123456789";
+  STATIC_CHECK(emio::detail::find_group<true>(input.data(), input.data() + input.size(), ";") == input.data() + 9);
+  STATIC_CHECK(emio::detail::find_group<false>(input.data() + 16, input.data() + input.size(), "0123456789") ==
+               input.data() + input.size());
+}
@@ -0,0 +1,220 @@
+// Unit under test.
+#include "emio/detail/format/grisu.hpp"
+
+// Other includes.
+#include <bit>
+#include <cmath>
+#include <random>
+
+#include "catch2/catch_test_macros.hpp"
+
+namespace emf = emio::detail::format;
+
+namespace {
+
+constexpr size_t max_sig_digits = std::numeric_limits<double>::max_digits10;
+
+std::optional<std::string> shortest_opt(double d, int16_t& k) {
+  const auto decoded = emf::decode(d);
+  REQUIRE(decoded.category == emf::category::finite);
+
+  std::array<char, max_sig_digits> buf{};
+  const auto res = emf::format_shortest_opt(decoded.finite, buf);
+  if (!res) {
+    return std::nullopt;
+  }
+  k = res->exp;
+  return std::string{res->digits.begin(), res->digits.end()};
+}
+
+std::pair<std::string, int16_t> shortest_dragon(double d) {
+  const auto decoded = emf::decode(d);
+  std::array<char, max_sig_digits> buf{};
+  const auto [digits, k] = emf::format_shortest(decoded.finite, buf);
+  return {std::string{digits.begin(), digits.end()}, k};
+}
+
+}  // namespace
+
+TEST_CASE("cached_power") {
+  CHECK(emf::cached_pow10.front().e == emf::cached_pow10_first_e);
+  CHECK(emf::cached_pow10.back().e == emf::cached_pow10_last_e);
+
+  // Full range for double.
+  for (int16_t e = -1137; e < 961; e++) {
+    const auto low = static_cast<int16_t>(emf::grisu_alpha - e - 64);
+    const auto high = static_cast<int16_t>(emf::grisu_gamma - e - 64);
+    const emf::cached_pow10_t cached = emf::cached_power(low, high);
+    INFO("e: " << e);
+    CHECK(low <= cached.e);
+    CHECK(cached.e <= high);
+  }
+}
+
+TEST_CASE("max_pow10_no_more_than") {
+  uint32_t prev_ten_k = 1;
+  for (uint8_t k = 1; k < 10; k++) {
+    const uint32_t ten_k = prev_ten_k * 10;
+    const emf::max_pow10_t below = emf::max_pow10_no_more_than(ten_k - 1);
+    CHECK(below.kappa == k - 1);
+    CHECK(below.ten_kappa == prev_ten_k);
+    const emf::max_pow10_t exact = emf::max_pow10_no_more_than(ten_k);
+    CHECK(exact.kappa == k);
+    CHECK(exact.ten_kappa == ten_k);
+    prev_ten_k = ten_k;
+  }
+}
+
+TEST_CASE("format_shortest_opt") {
+  int16_t k{};
+
+  CHECK(shortest_opt(0.1, k) == "1");
+  CHECK(k == 0);
+
+  CHECK(shortest_opt(100.0, k) == "1");
+  CHECK(k == 3);
+
+  CHECK(shortest_opt(1.0 / 3.0, k) == "3333333333333333");
+  CHECK(k == 0);
+
+  CHECK(shortest_opt(3.141592, k) == "3141592");
+  CHECK(k == 1);
+
+  CHECK(shortest_opt(3.141592e17, k) == "3141592");
+  CHECK(k == 18);
+
+  CHECK(shortest_opt(std::numeric_limits<double>::max(), k) == "17976931348623157");
+  CHECK(k == 309);
+
+  CHECK(shortest_opt(std::numeric_limits<double>::min(), k) == "22250738585072014");
+  CHECK(k == -307);
+
+  CHECK(shortest_opt(std::ldexp(1.0, -1074), k) == "5");
+  CHECK(k == -323);
+
+  SECTION("equally closest representations must fall back") {
+    CHECK(!shortest_opt(1.00000762939453125, k));
+  }
+
+  SECTION("compile-time") {
+    constexpr bool success = [] {
+      std::array<char, max_sig_digits> buf{};
+      const auto res = emf::format_shortest_opt(emf::decode(392.65).finite, buf);
+      return res && std::string_view{res->digits.begin(), res->digits.end()} == "39265" && res->exp == 3;
+    }();
+    STATIC_CHECK(success);
+  }
+}
+
+TEST_CASE("format_shortest_opt equals dragon") {
+  // Every result produced by Grisu must be identical to the one of Dragon4.
+  std::mt19937_64 gen{42};  // NOLINT(cert-msc32-c,cert-msc51-cpp): deterministic on purpose
+  size_t fallbacks = 0;
+  constexpr size_t n = 100'000;
+  for (size_t i = 0; i < n; i++) {
+    const auto d = std::bit_cast<double>(gen());
+    if (!std::isfinite(d) || d == 0) {
+      continue;
+    }
+    int16_t k{};
+    const std::optional<std::string> grisu = shortest_opt(d, k);
+    if (!grisu) {
+      fallbacks++;
+      continue;
+    }
+    const auto [dragon, dragon_k] = shortest_dragon(d);
+    INFO(d);
+    REQUIRE(*grisu == dragon);
+    REQUIRE(k == dragon_k);
+  }
+  // Grisu should handle nearly all values by itself.
+  CHECK(fallbacks < n / 100);
+}
+
+namespace {
+
+std::optional<std::pair<std::string, int16_t>> exact_opt(double d, emf::format_exact_mode mode, int16_t digits) {
+  const auto decoded = emf::decode(d);
+  std::array<char, emf::grisu_exact_max_digits> buf{};
+  const auto res = emf::format_exact_opt(decoded.finite, buf, mode, digits);
+  if (!res) {
+    return std::nullopt;
+  }
+  return std::pair{std::string{res->digits.begin(), res->digits.end()}, res->exp};
+}
+
+std::pair<std::string, int16_t> exact_dragon(double d, emf::format_exact_mode mode, int16_t digits) {
+  const auto decoded = emf::decode(d);
+  emio::memory_buffer buf;
+  const auto [str, k] = emf::format_exact(decoded.finite, buf, mode, digits);
+  return {std::string{str.begin(), str.end()}, k};
+}
+
+}  // namespace
+
+TEST_CASE("format_exact_opt") {
+  using emf::format_exact_mode;
+  using res_t = std::pair<std::string, int16_t>;
+
+  CHECK(exact_opt(0.1, format_exact_mode::significand_digits, 1) == res_t{"1", 0});
+  CHECK(exact_opt(0.1, format_exact_mode::significand_digits, 17) == res_t{"10000000000000001", 0});
+  CHECK(exact_opt(392.65, format_exact_mode::significand_digits, 7) == res_t{"3926500", 3});
+  CHECK(exact_opt(392.65, format_exact_mode::decimal_point, 2) == res_t{"39265", 3});
+  CHECK(exact_opt(42.0, format_exact_mode::decimal_point, 2) == res_t{"4200", 2});
+  CHECK(exact_opt(0.9999, format_exact_mode::decimal_point, 3) == res_t{"100", 1});
+  CHECK(exact_opt(9.6, format_exact_mode::decimal_point, 0) == res_t{"1", 2});
+  CHECK(exact_opt(0.6, format_exact_mode::decimal_point, 0) == res_t{"1", 1});
+  CHECK(exact_opt(0.4, format_exact_mode::decimal_point, 0) == res_t{"", 0});
+  CHECK(exact_opt(std::numeric_limits<double>::max(), format_exact_mode::significand_digits, 6) ==
+        res_t{"179769", 309});
+
+  SECTION("too many digits") {
+    CHECK(!exact_opt(0.1, format_exact_mode::significand_digits, 40));
+    CHECK(!exact_opt(0.1, format_exact_mode::decimal_point, 30));
+    CHECK(!exact_opt(1e100, format_exact_mode::decimal_point, 0));
+  }
+
+  SECTION("ties must fall back") {
+    // 0.125 and 9.5 are exactly representable and therefore a tie.
+    CHECK(!exact_opt(0.125, format_exact_mode::decimal_point, 2));
+    CHECK(!exact_opt(9.5, format_exact_mode::decimal_point, 0));
+  }
+
+  SECTION("compile-time") {
+    constexpr bool success = [] {
+      std::array<char, emf::grisu_exact_max_digits> buf{};
+      const auto res =
+          emf::format_exact_opt(emf::decode(42.24).finite, buf, emf::format_exact_mode::decimal_point, 2);
+      return res && std::string_view{res->digits.begin(), res->digits.end()} == "4224" && res->exp == 2;
+    }();
+    STATIC_CHECK(success);
+  }
+}
+
+TEST_CASE("format_exact_opt equals dragon") {
+  // Every result produced by Grisu must be identical to the one of Dragon4.
+  std::mt19937_64 gen{42};  // NOLINT(cert-msc32-c,cert-msc51-cpp): deterministic on purpose
+  std::uniform_int_distribution<int16_t> digits_dist{0, 24};
+  std::uniform_real_distribution<double> typical_dist{-1e6, 1e6};
+
+  size_t fallbacks = 0;
+  constexpr size_t n = 50'000;
+  for (size_t i = 0; i < n; i++) {
+    const double d = (i % 2 == 0) ? std::bit_cast<double>(gen()) : typical_dist(gen);
+    if (!std::isfinite(d) || d == 0) {
+      continue;
+    }
+    const int16_t digits = digits_dist(gen);
+    INFO(d << " with " << digits << " digits");
+
+    for (const auto mode : {emf::format_exact_mode::significand_digits, emf::format_exact_mode::decimal_point}) {
+      const auto grisu = exact_opt(d, mode, digits);
+      if (!grisu) {
+        fallbacks++;
+        continue;
+      }
+      REQUIRE(*grisu == exact_dragon(d, mode, digits));
+    }
+  }
+  CHECK(fallbacks < n);
+}
@@ -3,6 +3,8 @@
 
 // Other includes.
 #include <catch2/catch_test_macros.hpp>
+#include <emio/buffer.hpp>
+#include <string>
 
 namespace {
 
@@ -189,3 +191,105 @@ TEST_CASE("write_escaped") {
     }
   }
 }
+
+TEST_CASE("find_escape") {
+  // Test strategy:
+  // * Search the first char which needs to be escaped in inputs of different lengths (short ones are searched scalar,
+  //   longer ones with a vector kernel and a scalar tail) with the char at every position.
+  // Expected: The position of the char is found, or the end if no char needs to be escaped.
+
+  constexpr std::string_view to_escape = "\x00\x1f\x7f\x80\xff\\'\""sv;
+
+  for (size_t size = 0; size <= 70; size++) {
+    std::string input(size, 'a');
+    CHECK(emio::detail::find_escape(input.data(), input.data() + size) == input.data() + size);
+
+    for (size_t pos = 0; pos < size; pos++) {
+      for (const char c : to_escape) {
+        input[pos] = c;
+        CHECK(emio::detail::find_escape(input.data(), input.data() + size) == input.data() + pos);
+        // A later char which needs to be escaped doesn't matter.
+        input.back() = '\n';
+        CHECK(emio::detail::find_escape(input.data(), input.data() + size) == input.data() + pos);
+        input.back() = 'a';
+        input[pos] = 'a';
+      }
+    }
+  }
+  SECTION("no escape") {
+    constexpr std::string_view input = " !/09:@AZ[`az~ !/09:@AZ[`az~ !/09:@AZ[`az~ !/09:@AZ[`az~";
+    CHECK(emio::detail::find_escape(input.data(), input.data() + input.size()) == input.data() + input.size());
+  }
+  SECTION("compile-time") {
+    constexpr std::string_view input = "abcdefghijklmnopqrstuvwxyz\t";
+    STATIC_CHECK(emio::detail::find_escape(input.data(), input.data() + input.size()) == input.data() + 26);
+  }
+}
+
+TEST_CASE("write_escaped with long input") {
+  // Test strategy:
+  // * Escape long inputs with runs of chars which need no escaping and chars which need escaping in between.
+  // * Write them in one pass, chunk by chunk and through write_str_escaped into buffers with different capacities.
+  // Expected: The output is always the same and matches the counted size.
+
+  std::string input;
+  std::string expected;
+  for (size_t i = 0; i < 20; i++) {
+    const std::string run(i * 3, static_cast<char>('a' + i));
+    input += run;
+    expected += run;
+    input += (i % 2 == 0) ? '\n' : '\x81';
+    expected += (i % 2 == 0) ? "\\n" : "\\x81";
+  }
+
+  CHECK(test_escape(input, expected));
+
+  SECTION("chunk by chunk") {
+    for (size_t chunk_size = 1; chunk_size <= 40; chunk_size++) {
+      emio::detail::write_escaped_helper helper{input};
+      std::string output;
+      std::string chunk(chunk_size, '\0');
+      while (!helper.done()) {
+        const size_t written = helper.write_escaped(chunk);
+        output.append(chunk.data(), written);
+      }
+      CHECK(output == expected);
+      CHECK(helper.max_remaining_size() == 0);
+    }
+  }
+  SECTION("write_str_escaped into a growing buffer") {
+    emio::memory_buffer buf;
+    REQUIRE(emio::detail::write_str_escaped(buf, input, '"'));
+    CHECK(buf.view() == '"' + expected + '"');
+    // The worst case size doesn't fit into the current write area. Only the escaped size is requested.
+    CHECK(buf.capacity() < input.size() * emio::detail::max_escape_sequence_size);
+  }
+  SECTION("write_str_escaped into a growing buffer with enough capacity") {
+    const size_t capacity = input.size() * emio::detail::max_escape_sequence_size + 2;
+    emio::memory_buffer buf{capacity};
+    REQUIRE(buf.get_remaining_write_area_size() >= capacity);
+    REQUIRE(emio::detail::write_str_escaped(buf, input, '"'));
+    CHECK(buf.view() == '"' + expected + '"');
+    CHECK(buf.capacity() == capacity);
+  }
+  SECTION("write_str_escaped into a fixed size buffer") {
+    for (size_t size = 0; size <= expected.size() + 2; size++) {
+      std::string storage(size, '\0');
+      emio::span_buffer buf{storage};
+      const emio::result<void> res = emio::detail::write_str_escaped(buf, input, '"');
+      if (size < expected.size() + 2) {
+        CHECK(res == emio::err::eof);
+      } else {
+        REQUIRE(res);
+        CHECK(buf.view() == '"' + expected + '"');
+      }
+    }
+  }
+  SECTION("write_str_escaped releases the unused write area") {
+    std::string storage(500, '\0');
+    emio::span_buffer buf{storage};
+    REQUIRE(emio::detail::write_str_escaped(buf, "abc", '\''));
+    REQUIRE(emio::detail::write_str_escaped(buf, "\t", '\''));
+    CHECK(buf.view() == "'abc''\\t'");
+  }
+}
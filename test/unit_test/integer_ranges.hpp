@@ -5,6 +5,12 @@
 
 namespace emio::test {
 
+#if defined(__SIZEOF_INT128__) && !defined(__STRICT_ANSI__)
+#  define EMIO_TEST_HAS_INT128
+__extension__ typedef __int128 int128_t;
+__extension__ typedef unsigned __int128 uint128_t;
+#endif
+
 inline constexpr std::tuple integer_ranges{
     std::tuple{
         std::type_identity<bool>{},
@@ -51,6 +57,21 @@ inline constexpr std::tuple integer_ranges{
         std::tuple{"1", "0", "-1", "-10"},
         std::tuple{"18446744073709551614", "18446744073709551615", "18446744073709551616", "184467440737095516150"},
     },
+#if defined(EMIO_TEST_HAS_INT128)
+    std::tuple{
+        std::type_identity<int128_t>{},
+        std::tuple{"-170141183460469231731687303715884105727", "-170141183460469231731687303715884105728",
+                   "-170141183460469231731687303715884105729", "-1701411834604692317316873037158841057280"},
+        std::tuple{"170141183460469231731687303715884105726", "170141183460469231731687303715884105727",
+                   "170141183460469231731687303715884105728", "1701411834604692317316873037158841057270"},
+    },
+    std::tuple{
+        std::type_identity<uint128_t>{},
+        std::tuple{"1", "0", "-1", "-10"},
+        std::tuple{"340282366920938463463374607431768211454", "340282366920938463463374607431768211455",
+                   "340282366920938463463374607431768211456", "3402823669209384634633746074317682114550"},
+    },
+#endif
 };
 
 template <typename T>
@@ -5,6 +5,10 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
 #include <catch2/generators/catch_generators_range.hpp>
+#include <memory_resource>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 namespace {
 
@@ -75,6 +79,33 @@ constexpr bool check_equality_of_buffer(T& expected, T& other, bool data_ptr_is_
   return result;
 }
 
+// Counts the allocated and deallocated chars.
+struct allocation_counter {
+  size_t allocated{};
+  size_t deallocated{};
+};
+
+template <typename T>
+struct counting_allocator {
+  using value_type = T;
+
+  explicit counting_allocator(allocation_counter& counter) : counter_{&counter} {}
+
+  T* allocate(size_t n) {
+    counter_->allocated += n;
+    return std::allocator<T>{}.allocate(n);
+  }
+
+  void deallocate(T* p, size_t n) {
+    counter_->deallocated += n;
+    std::allocator<T>{}.deallocate(p, n);
+  }
+
+  friend bool operator==(const counting_allocator&, const counting_allocator&) = default;
+
+  allocation_counter* counter_;
+};
+
 template <typename T>
 void check_gang_of_5(T& buf, bool data_ptr_is_different) {
   SECTION("copy-construct") {
@@ -308,6 +339,85 @@ TEST_CASE("memory_buffer at compile-time", "[buffer]") {
   STATIC_CHECK(success);
 }
 
+TEST_CASE("memory_buffer with allocator", "[buffer]") {
+  // Test strategy:
+  // * Construct a memory_buffer with a counting allocator.
+  // * Write more than the internal storage size into the buffer, copy and destroy it.
+  // Expected: Only the growth beyond the internal storage is allocated and everything is deallocated.
+
+  allocation_counter counter;
+  {
+    emio::memory_buffer<15, counting_allocator<char>> buf{counting_allocator<char>{counter}};
+    CHECK(buf.get_allocator() == counting_allocator<char>{counter});
+
+    fill(buf.get_write_area_of(10), 'x');
+    CHECK(counter.allocated == 0);
+
+    fill(buf.get_write_area_of(20), 'y');
+    const size_t allocated = counter.allocated;
+    CHECK(allocated >= 30);
+    CHECK(counter.deallocated == 0);
+    CHECK(buf.view() == std::string(10, 'x') + std::string(20, 'y'));
+
+    const emio::memory_buffer<15, counting_allocator<char>> buf2{buf};
+    CHECK(buf2.view() == buf.view());
+    CHECK(counter.allocated > allocated);
+  }
+  CHECK(counter.deallocated == counter.allocated);
+}
+
+TEST_CASE("pmr::memory_buffer", "[buffer]") {
+  // Test strategy:
+  // * Construct a pmr::memory_buffer with a monotonic arena which cannot fall back to the heap.
+  // * Write more than the internal storage size into the buffer.
+  // Expected: The growth is allocated from the arena and everything is correctly written.
+
+  std::array<char, 16 * 1024> arena_storage{};
+  std::pmr::monotonic_buffer_resource arena{arena_storage.data(), arena_storage.size(),
+                                            std::pmr::null_memory_resource()};
+
+  emio::pmr::memory_buffer<15> buf{&arena};
+  CHECK(buf.get_allocator().resource() == &arena);
+
+  std::string expected;
+  for (size_t i = 0; i < 20; i++) {
+    const emio::result<std::span<char>> area = buf.get_write_area_of(i + 1);
+    fill(area, static_cast<char>('a' + i));
+    expected.append(i + 1, static_cast<char>('a' + i));
+  }
+  CHECK(buf.view() == expected);
+  CHECK(buf.view().data() >= arena_storage.data());
+  CHECK(buf.view().data() < arena_storage.data() + arena_storage.size());
+
+  // A move with another resource copies instead of adopting the storage.
+  emio::pmr::memory_buffer<15> copied{buf};
+  const emio::pmr::memory_buffer<15> moved{std::move(copied), std::pmr::new_delete_resource()};
+  CHECK(moved.get_allocator().resource() == std::pmr::new_delete_resource());
+  CHECK(moved.view() == expected);
+  CHECK(copied.view().empty());
+
+  // Containers of the arena pass it to their buffers.
+  std::pmr::vector<emio::pmr::memory_buffer<15>> bufs{&arena};
+  bufs.emplace_back();
+  bufs.push_back(moved);
+  CHECK(bufs[0].get_allocator().resource() == &arena);
+  CHECK(bufs[1].get_allocator().resource() == &arena);
+  CHECK(bufs[1].view() == expected);
+
+  // The other buffers allocate from the default resource. Their storage is copied instead of adopted.
+  check_gang_of_5(buf, true);
+
+  // Moves which may copy into a storage of another resource may throw.
+  using pmr_buffer = emio::pmr::memory_buffer<15>;
+  STATIC_CHECK(std::is_nothrow_move_constructible_v<pmr_buffer>);
+  STATIC_CHECK(!std::is_nothrow_constructible_v<pmr_buffer, pmr_buffer&&, const pmr_buffer::allocator_type&>);
+  STATIC_CHECK(!std::is_nothrow_move_assignable_v<pmr_buffer>);
+  using std_buffer = emio::memory_buffer<15>;
+  STATIC_CHECK(std::is_nothrow_move_constructible_v<std_buffer>);
+  STATIC_CHECK(std::is_nothrow_constructible_v<std_buffer, std_buffer&&, const std_buffer::allocator_type&>);
+  STATIC_CHECK(std::is_nothrow_move_assignable_v<std_buffer>);
+}
+
 TEST_CASE("span_buffer", "[buffer]") {
   // Test strategy:
   // * Construct a span_buffer from an std::array.
@@ -0,0 +1,182 @@
+// Unit under test.
+#include <emio/format.hpp>
+
+// Other includes.
+#include <catch2/catch_test_macros.hpp>
+#include <emio/ranges.hpp>
+#include <vector>
+
+using namespace std::string_view_literals;
+
+namespace {
+
+template <typename... Args>
+std::string format_compiled(std::string_view str, const Args&... args) {
+  const emio::result<emio::compiled_format<Args...>> compiled = emio::compiled_format<Args...>::from(str);
+  REQUIRE(compiled);
+  emio::result<std::string> res = emio::format(*compiled, args...);
+  REQUIRE(res);
+  return *res;
+}
+
+}  // namespace
+
+TEST_CASE("compiled_format", "[compiled_format]") {
+  // Test strategy:
+  // * Compile format strings with literals, escape sequences, automatic and positional arguments and format specs.
+  // Expected: The results are the same as with a runtime format string.
+
+  const auto check = []<typename... Args>(std::string_view str, const Args&... args) {
+    INFO(str);
+    CHECK(format_compiled(str, args...) == emio::format(emio::runtime(str), args...));
+  };
+
+  check("");
+  check("abc");
+  check("{{");
+  check("}}");
+  check("{{}}");
+  check("a{{b}}c{{{{d");
+  check("{}", 42);
+  check("{} {}", 42, "abc"sv);
+  check("x{:>5}y{:08.3f}z", 'c', 3.14159);
+  check("{{{:x}}}", 255);
+  check("{{}}{}{{}}", true);
+  check("{1}{{{0}}}", 1, 2);
+  check("{2:#x} {0:s} {1:e}", "str"sv, 1.5, 42U);
+  check("{::x}", std::vector<int>{1, 2, 3});
+  check("{0} {0}", 42);
+  check("{0}={0:#x} {1}{0:+}{1:*^5}", 255, 'c');
+}
+
+TEST_CASE("compiled_format is reusable", "[compiled_format]") {
+  // Test strategy:
+  // * Compile a format string once and format different argument values.
+  // Expected: The parsed format specs are reused for every value.
+
+  const auto compiled = emio::compiled_format<int, std::string_view>::from("[{:+05}|{:^7}]");
+  REQUIRE(compiled);
+
+  CHECK(emio::format(*compiled, 42, "ab") == "[+0042|  ab   ]");
+  CHECK(emio::format(*compiled, -7, "abcdefgh") == "[-0007|abcdefgh]");
+  CHECK(emio::formatted_size(*compiled, 1, "") == 15U);
+
+  SECTION("format_to buffer") {
+    emio::static_buffer<15> buf;
+    REQUIRE(emio::format_to(buf, *compiled, 1, "x"));
+    CHECK(buf.view() == "[+0001|   x   ]");
+
+    CHECK(emio::format_to(buf, *compiled, 1, "x") == emio::err::eof);
+  }
+
+  SECTION("format_to writer") {
+    emio::memory_buffer buf;
+    emio::writer wtr{buf};
+    REQUIRE(emio::format_to(wtr, *compiled, 3, "y"));
+    REQUIRE(emio::format_to(wtr, *compiled, 4, "z"));
+    CHECK(buf.view() == "[+0003|   y   ][+0004|   z   ]");
+  }
+
+  SECTION("format_to output iterator") {
+    std::string s;
+    REQUIRE(emio::format_to(std::back_inserter(s), *compiled, 5, "w"));
+    CHECK(s == "[+0005|   w   ]");
+  }
+}
+
+TEST_CASE("compiled_format with invalid format strings", "[compiled_format]") {
+  // Test strategy:
+  // * Compile invalid format strings or format strings not matching the argument types.
+  // Expected: The compilation fails with invalid_format.
+
+  CHECK(emio::compiled_format<int>::from("{") == emio::err::invalid_format);
+  CHECK(emio::compiled_format<int>::from("}") == emio::err::invalid_format);
+  CHECK(emio::compiled_format<int>::from("{:s}") == emio::err::invalid_format);
+  CHECK(emio::compiled_format<int>::from("{} {}") == emio::err::invalid_format);
+  CHECK(emio::compiled_format<int, int>::from("{}") == emio::err::invalid_format);
+  CHECK(emio::compiled_format<>::from("{}") == emio::err::invalid_format);
+  CHECK(emio::compiled_format<int>::from(emio::runtime("{:d}")));
+}
+
+TEST_CASE("compiled_format with many replacement fields", "[compiled_format]") {
+  // Test strategy:
+  // * Compile format strings with more replacement fields than arguments.
+  // Expected: The fields are limited by the maximum number of fields.
+
+  CHECK(emio::basic_compiled_format<3, int>::from("{0}{0}{0}"));
+  CHECK(emio::basic_compiled_format<3, int>::from("{0}{0}{0}{0}") == emio::err::out_of_range);
+
+  std::string fields;
+  for (size_t i = 0; i < emio::default_max_compiled_fields; i++) {
+    fields += "{0}";
+  }
+  const auto compiled = emio::compiled_format<int>::from(fields);
+  REQUIRE(compiled);
+  CHECK(compiled->field_count() == emio::default_max_compiled_fields);
+  CHECK(emio::format(*compiled, 7) == std::string(emio::default_max_compiled_fields, '7'));
+  CHECK(emio::compiled_format<int>::from(fields + "{0}") == emio::err::out_of_range);
+}
+
+TEST_CASE("compiled_format at compile-time", "[compiled_format]") {
+  constexpr bool success = [] {
+    const auto compiled = emio::compiled_format<int, char>::from("{{{1}:{0:x}}}");
+    if (!compiled) {
+      return false;
+    }
+    emio::static_buffer<8> buf;
+    if (!emio::format_to(buf, *compiled, 255, 'c')) {
+      return false;
+    }
+    return buf.view() == "{c:ff}";
+  }();
+  STATIC_CHECK(success);
+}
+
+TEST_CASE("emio::compile", "[compiled_format]") {
+  // Test strategy:
+  // * Format with format strings compiled at compile-time.
+  // Expected: The results are the same as with a not compiled format string.
+
+  CHECK(emio::format(emio::compile<"">) == "");
+  CHECK(emio::format(emio::compile<"abc">) == "abc");
+  CHECK(emio::format(emio::compile<"a{{b}}c{{{{d">) == "a{b}c{{d");
+  CHECK(emio::format(emio::compile<"{}">, 42) == "42");
+  CHECK(emio::format(emio::compile<"{} {}">, 42, "abc") == "42 abc");
+  CHECK(emio::format(emio::compile<"x{:>5}y{:08.3f}z">, 'c', 3.14159) == "x    cy0003.142z");
+  CHECK(emio::format(emio::compile<"{{{:x}}}">, 255) == "{ff}");
+  CHECK(emio::format(emio::compile<"{2:#x} {0:s} {1:e}">, "str"sv, 1.5, 42U) == "0x2a str 1.500000e+00");
+  CHECK(emio::format(emio::compile<"{::x}">, std::vector<int>{1, 2, 3}) == "[1, 2, 3]");
+  CHECK(emio::format(emio::compile<"{0}={0:#x} {1}{0:+}{1:*^5}">, 255, 'c') == "255=0xff c+255**c**");
+  STATIC_CHECK(emio::max_formatted_size_v<"{0}{0:d}", bool> == 8);
+  CHECK(emio::formatted_size(emio::compile<"{:+05}">, 1) == 5);
+
+  SECTION("format_to buffer") {
+    emio::static_buffer<5> buf;
+    REQUIRE(emio::format_to(buf, emio::compile<"{:+05}">, 1));
+    CHECK(buf.view() == "+0001");
+    CHECK(emio::format_to(buf, emio::compile<"{}">, 1) == emio::err::eof);
+  }
+
+  SECTION("format_to writer") {
+    emio::memory_buffer buf;
+    emio::writer wtr{buf};
+    REQUIRE(emio::format_to(wtr, emio::compile<"{}-">, 1));
+    REQUIRE(emio::format_to(wtr, emio::compile<"{}">, 2));
+    CHECK(buf.view() == "1-2");
+  }
+
+  SECTION("format_to output iterator") {
+    std::string s;
+    REQUIRE(emio::format_to(std::back_inserter(s), emio::compile<"[{}]">, 5));
+    CHECK(s == "[5]");
+  }
+
+  SECTION("compile-time") {
+    constexpr bool success = [] {
+      std::array<char, 6> arr{};
+      const emio::result<char*> res = emio::format_to(arr.data(), emio::compile<"{{{1}:{0:x}}}">, 255, 'c');
+      return res == arr.data() + arr.size() && std::string_view{arr.data(), arr.size()} == "{c:ff}";
+    }();
+    STATIC_CHECK(success);
+  }
+}
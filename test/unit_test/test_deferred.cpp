@@ -0,0 +1,141 @@
+// Unit under test.
+#include <emio/deferred.hpp>
+
+// Other includes.
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <limits>
+#include <string>
+
+#include "integer_ranges.hpp"
+
+using namespace std::string_view_literals;
+
+namespace {
+
+// Captures the arguments into a record, checks the record size and formats it.
+template <typename... Args>
+[[nodiscard]] std::string round_trip(const emio::format_string<Args...>& format_str, const Args&... args) {
+  emio::memory_buffer records;
+  REQUIRE(emio::defer_to(records, format_str, args...));
+  REQUIRE(records.view().size() == emio::deferred_size(format_str, args...));
+
+  emio::memory_buffer out;
+  const emio::result<size_t> res = emio::format_deferred_to(out, records.view());
+  REQUIRE(res);
+  CHECK(res.value() == records.view().size());
+  return out.str();
+}
+
+}  // namespace
+
+TEST_CASE("deferred formatting round-trips every core type", "[deferred]") {
+  // Test strategy:
+  // * Capture arguments of every core type (and types which are unified to them) into a binary record.
+  // * Format the record later.
+  // Expected: The output is the same as if the arguments were formatted directly.
+
+  SECTION("bool and char") {
+    CHECK(round_trip("{} {:d} {} {:?} {:x}", true, false, 'a', '\n', 'z') == "true 0 a '\\n' 7a");
+  }
+  SECTION("integers") {
+    CHECK(round_trip("{} {} {} {} {} {} {} {}", std::numeric_limits<int8_t>::min(),
+                     std::numeric_limits<uint8_t>::max(), std::numeric_limits<int16_t>::min(),
+                     std::numeric_limits<uint16_t>::max(), std::numeric_limits<int32_t>::min(),
+                     std::numeric_limits<uint32_t>::max(), std::numeric_limits<int64_t>::min(),
+                     std::numeric_limits<uint64_t>::max()) ==
+          "-128 255 -32768 65535 -2147483648 4294967295 -9223372036854775808 18446744073709551615");
+    CHECK(round_trip("{:#x} {:+08d} {:^7b}", 255L, 42LL, 5U) == "0xff +0000042   101  ");
+  }
+#if defined(EMIO_TEST_HAS_INT128)
+  SECTION("128-bit integers") {
+    const emio::test::int128_t min = std::numeric_limits<emio::test::int128_t>::min();
+    const emio::test::uint128_t max = std::numeric_limits<emio::test::uint128_t>::max();
+    CHECK(round_trip("{} {:x}", min, max) ==
+          "-170141183460469231731687303715884105728 ffffffffffffffffffffffffffffffff");
+  }
+#endif
+  SECTION("floating-points") {
+    CHECK(round_trip("{} {} {:.3e} {:>8.2f}", 0.1, 1.5F, -6.02214076e-23, M_PI) == "0.1 1.5 -6.022e-23     3.14");
+    CHECK(round_trip("{} {} {}", std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::quiet_NaN(),
+                     std::numeric_limits<double>::denorm_min()) == "inf -nan 5e-324");
+  }
+  SECTION("strings") {
+    const std::string str{"std::string"};
+    const char* c_str = "const char*";
+    constexpr char array[] = "char array";  // NOLINT(modernize-avoid-c-arrays): test case
+    CHECK(round_trip("{}, {}, {}, {}, {:?}, '{}'", "literal"sv, str, c_str, array, "a\tb"sv, ""sv) ==
+          "literal, std::string, const char*, char array, \"a\\tb\", ''");
+    CHECK(round_trip("{:*^9.3}", "string"sv) == "***str***");
+  }
+  SECTION("pointers") {
+    const void* ptr = reinterpret_cast<const void*>(0x1234);  // NOLINT: test case
+    CHECK(round_trip("{} {} {}", nullptr, ptr, static_cast<void*>(nullptr)) == "0x0 0x1234 0x0");
+  }
+  SECTION("no arguments") {
+    CHECK(round_trip("plain text") == "plain text");
+    CHECK(round_trip("{{escaped}}") == "{escaped}");
+  }
+}
+
+TEST_CASE("deferred formatting of multiple records", "[deferred]") {
+  // Test strategy:
+  // * Capture several records one after another into the same buffer. The strings are changed afterwards.
+  // * Format them one by one.
+  // Expected: The records are formatted in order with the captured values.
+
+  emio::memory_buffer records;
+  std::string str{"first"};
+  REQUIRE(emio::defer_to(records, "{}: {}", 1, str));
+  str = "second";
+  REQUIRE(emio::defer_to(records, "{}: {} {}", 2, str, 2.5));
+  str.clear();
+  REQUIRE(emio::defer_to(records, "done"));
+
+  emio::memory_buffer out;
+  std::string_view remaining = records.view();
+  while (!remaining.empty()) {
+    const emio::result<size_t> size = emio::format_deferred_to(out, remaining);
+    REQUIRE(size);
+    remaining.remove_prefix(size.value());
+    REQUIRE(emio::format_to(out, "\n"));
+  }
+  CHECK(out.view() == "1: first\n2: second 2.5\ndone\n");
+}
+
+TEST_CASE("deferred formatting errors", "[deferred]") {
+  // Test strategy:
+  // * Capture records into buffers which are too small or with invalid format strings.
+  // * Format truncated records or into output buffers which are too small.
+  // Expected: The errors are reported.
+
+  SECTION("invalid format string") {
+    emio::memory_buffer records;
+    CHECK(emio::defer_to(records, emio::runtime("{"), 1) == emio::err::invalid_format);
+    CHECK(records.view().empty());
+  }
+  SECTION("buffer too small") {
+    const size_t size = emio::deferred_size("{}", 42);
+    std::string too_small(size - 1, '\0');
+    emio::span_buffer buf{too_small};
+    CHECK(emio::defer_to(buf, "{}", 42) == emio::err::eof);
+  }
+  SECTION("truncated record") {
+    emio::memory_buffer records;
+    REQUIRE(emio::defer_to(records, "{}", "some string"sv));
+    const std::string_view record = records.view();
+
+    emio::memory_buffer out;
+    CHECK(emio::format_deferred_to(out, {}) == emio::err::invalid_data);
+    CHECK(emio::format_deferred_to(out, record.substr(0, 4)) == emio::err::invalid_data);
+    CHECK(emio::format_deferred_to(out, record.substr(0, record.size() - 1)) == emio::err::invalid_data);
+    CHECK(out.view().empty());
+  }
+  SECTION("output buffer too small") {
+    emio::memory_buffer records;
+    REQUIRE(emio::defer_to(records, "{}", 12345));
+
+    emio::static_buffer<4> out;
+    CHECK(emio::format_deferred_to(out, records.view()) == emio::err::eof);
+  }
+}
@@ -2,9 +2,16 @@
 #include <emio/format.hpp>
 
 // Other includes.
+#include <array>
+#include <bit>
 #include <catch2/catch_test_macros.hpp>
 #include <climits>
 #include <cmath>
+#include <cstdio>
+#include <limits>
+#include <numbers>
+
+#include "integer_ranges.hpp"
 
 using namespace std::string_view_literals;
 
@@ -463,16 +470,29 @@ TEST_CASE("format dec") {
   CHECK(emio::format("{0}", -42) == "-42");
   CHECK(emio::format("{0}", 12345) == "12345");
   CHECK(emio::format("{0}", 67890) == "67890");
-  //  #if FMT_USE_INT128
-  //  CHECK(emio::format("{0}", static_cast<__int128_t>(0)) == "0");
-  //  CHECK(emio::format("{0}", static_cast<__uint128_t>(0)) == "0");
-  //  CHECK(emio::format("{0}", static_cast<__int128_t>(INT64_MAX) + 1) == "9223372036854775808");
-  //  CHECK(emio::format("{0}", static_cast<__int128_t>(INT64_MIN) - 1) == "-9223372036854775809");
-  //  CHECK(emio::format("{0}", static_cast<__int128_t>(UINT64_MAX) + 1) == "18446744073709551616");
-  //  CHECK(emio::format("{0}", int128_max) == "170141183460469231731687303715884105727");
-  //  CHECK(emio::format("{0}", int128_min) == "-170141183460469231731687303715884105728");
-  //  CHECK(emio::format("{0}", uint128_max) == "340282366920938463463374607431768211455");
-  //  #endif
+#if defined(EMIO_TEST_HAS_INT128)
+  using emio::test::int128_t;
+  using emio::test::uint128_t;
+  constexpr int128_t int128_max = std::numeric_limits<int128_t>::max();
+  constexpr int128_t int128_min = std::numeric_limits<int128_t>::min();
+  constexpr uint128_t uint128_max = std::numeric_limits<uint128_t>::max();
+  CHECK(emio::format("{0}", static_cast<int128_t>(0)) == "0");
+  CHECK(emio::format("{0}", static_cast<uint128_t>(0)) == "0");
+  CHECK(emio::format("{0}", static_cast<int128_t>(INT64_MAX) + 1) == "9223372036854775808");
+  CHECK(emio::format("{0}", static_cast<int128_t>(INT64_MIN) - 1) == "-9223372036854775809");
+  CHECK(emio::format("{0}", static_cast<int128_t>(UINT64_MAX) + 1) == "18446744073709551616");
+  CHECK(emio::format("{0}", int128_max) == "170141183460469231731687303715884105727");
+  CHECK(emio::format("{0}", int128_min) == "-170141183460469231731687303715884105728");
+  CHECK(emio::format("{0}", uint128_max) == "340282366920938463463374607431768211455");
+  CHECK(emio::format("{0}", static_cast<uint128_t>(10'000'000'000'000'000'000U) * 10'000'000'000'000'000'000U) ==
+        "100000000000000000000000000000000000000");
+  CHECK(emio::format("{0}", static_cast<uint128_t>(10'000'000'000'000'000'000U) * 10'000'000'000'000'000'000U - 1) ==
+        "99999999999999999999999999999999999999");
+  CHECK(emio::format("{0}", static_cast<uint128_t>(10'000'000'000'000'000'000U) * 10'000'000'000'000'000'000U + 1) ==
+        "100000000000000000000000000000000000001");
+  CHECK(emio::format("{0:+>45}", int128_min) == "+++++-170141183460469231731687303715884105728");
+  CHECK(emio::format(emio::runtime("{0:+}"), int128_max) == "+170141183460469231731687303715884105727");
+#endif
 
   /*char buffer[buffer_size];
   safe_sprintf(buffer, "%d", INT_MIN);
@@ -498,16 +518,23 @@ TEST_CASE("format hex") {
   CHECK(emio::format("{0:x}", 0x90abcdef) == "90abcdef");
   CHECK(emio::format("{0:X}", 0x12345678) == "12345678");
   CHECK(emio::format("{0:X}", 0x90ABCDEF) == "90ABCDEF");
-  //  #if FMT_USE_INT128
-  //  CHECK(emio::format("{0:x}", static_cast<__int128_t>(0)) == "0");
-  //  CHECK(emio::format("{0:x}", static_cast<__uint128_t>(0)) == "0");
-  //  CHECK(emio::format("{0:x}", static_cast<__int128_t>(INT64_MAX) + 1) == "8000000000000000");
-  //  CHECK(emio::format("{0:x}", static_cast<__int128_t>(INT64_MIN) - 1) == "-8000000000000001");
-  //  CHECK(emio::format("{0:x}", static_cast<__int128_t>(UINT64_MAX) + 1) == "10000000000000000");
-  //  CHECK(emio::format("{0:x}", int128_max) == "7fffffffffffffffffffffffffffffff");
-  //  CHECK(emio::format("{0:x}", int128_min) == "-80000000000000000000000000000000");
-  //  CHECK(emio::format("{0:x}", uint128_max) == "ffffffffffffffffffffffffffffffff");
-  //  #endif
+#if defined(EMIO_TEST_HAS_INT128)
+  using emio::test::int128_t;
+  using emio::test::uint128_t;
+  constexpr int128_t int128_max = std::numeric_limits<int128_t>::max();
+  constexpr int128_t int128_min = std::numeric_limits<int128_t>::min();
+  constexpr uint128_t uint128_max = std::numeric_limits<uint128_t>::max();
+  CHECK(emio::format("{0:x}", static_cast<int128_t>(0)) == "0");
+  CHECK(emio::format("{0:x}", static_cast<uint128_t>(0)) == "0");
+  CHECK(emio::format("{0:x}", static_cast<int128_t>(INT64_MAX) + 1) == "8000000000000000");
+  CHECK(emio::format("{0:x}", static_cast<int128_t>(INT64_MIN) - 1) == "-8000000000000001");
+  CHECK(emio::format("{0:x}", static_cast<int128_t>(UINT64_MAX) + 1) == "10000000000000000");
+  CHECK(emio::format("{0:x}", int128_max) == "7fffffffffffffffffffffffffffffff");
+  CHECK(emio::format("{0:x}", int128_min) == "-80000000000000000000000000000000");
+  CHECK(emio::format("{0:x}", uint128_max) == "ffffffffffffffffffffffffffffffff");
+  CHECK(emio::format("{0:#b}", static_cast<uint128_t>(1) << 127) == "0b1" + std::string(127, '0'));
+  CHECK(emio::format("{0:o}", uint128_max) == "3777777777777777777777777777777777777777777");
+#endif
 
   /*char buffer[buffer_size];
   safe_sprintf(buffer, "-%x", 0 - static_cast<unsigned>(INT_MIN));
@@ -569,19 +596,19 @@ TEST_CASE("format_double") {
   CHECK(emio::format("{:f}", 392.65) == "392.650000");
   CHECK(emio::format("{:F}", 392.65) == "392.650000");
   //  CHECK(emio::format("{:L}", 42.0) == "42");
-  //  CHECK(emio::format("{:24a}", 4.2f) == "           0x1.0cccccp+2");
-  //  CHECK(emio::format("{:24a}", 4.2) == "    0x1.0cccccccccccdp+2");
-  //  CHECK(emio::format("{:<24a}", 4.2) == "0x1.0cccccccccccdp+2    ");
+  CHECK(emio::format("{:24a}", 4.2f) == "           0x1.0cccccp+2");
+  CHECK(emio::format("{:24a}", 4.2) == "    0x1.0cccccccccccdp+2");
+  CHECK(emio::format("{:<24a}", 4.2) == "0x1.0cccccccccccdp+2    ");
   CHECK(emio::format("{0:e}", 392.65) == "3.926500e+02");
   CHECK(emio::format("{0:E}", 392.65) == "3.926500E+02");
   CHECK(emio::format("{0:+010.4g}", 392.65) == "+0000392.6");
 
-  //  char buffer[buffer_size];
-  //  double xd = 0x1.ffffffffffp+2;
-  //  safe_sprintf(buffer, "%.*a", 10, xd);
-  //  CHECK(emio::format("{:.10a}", xd) == buffer);
-  //  safe_sprintf(buffer, "%.*a", 9, xd);
-  //  CHECK(emio::format("{:.9a}", xd) == buffer);
+  char buffer[32]{};
+  double xd = 0x1.ffffffffffp+2;
+  std::snprintf(buffer, sizeof(buffer), "%.*a", 10, xd);
+  CHECK(emio::format("{:.10a}", xd) == buffer);
+  std::snprintf(buffer, sizeof(buffer), "%.*a", 9, xd);
+  CHECK(emio::format("{:.9a}", xd) == buffer);
 
   //  if (std::numeric_limits<long double>::digits == 64) {
   //    auto ld = 0xf.ffffffffffp-3l;
@@ -593,28 +620,137 @@ TEST_CASE("format_double") {
   //    CHECK(emio::format("{:.9a}", ld) == buffer);
   //  }
 
-  //  if (fmt::detail::const_check(std::numeric_limits<double>::is_iec559)) {
-  //    double d = (std::numeric_limits<double>::min)();
-  //    CHECK(emio::format("{:a}", d) == "0x1p-1022");
-  //    CHECK(emio::format("{:#a}", d) == "0x1.p-1022");
-  //
-  //    d = (std::numeric_limits<double>::max)();
-  //    safe_sprintf(buffer, "%a", d);
-  //    CHECK(emio::format("{:a}", d) == buffer);
-  //
-  //    d = std::numeric_limits<double>::denorm_min();
-  //    CHECK(emio::format("{:a}", d) == "0x0.0000000000001p-1022");
-  //  }
+  if (std::numeric_limits<double>::is_iec559) {
+    double d = (std::numeric_limits<double>::min)();
+    CHECK(emio::format("{:a}", d) == "0x1p-1022");
+    CHECK(emio::format("{:#a}", d) == "0x1.p-1022");
 
-  //  safe_sprintf(buffer, "%.*a", 10, 4.2);
-  //  CHECK(emio::format("{:.10a}", 4.2) == buffer);
-  //
-  //  CHECK(emio::format("{:a}", -42.0) == "-0x1.5p+5");
-  //  CHECK(emio::format("{:A}", -42.0) == "-0X1.5P+5");
+    d = (std::numeric_limits<double>::max)();
+    std::snprintf(buffer, sizeof(buffer), "%a", d);
+    CHECK(emio::format("{:a}", d) == buffer);
+
+    d = std::numeric_limits<double>::denorm_min();
+    CHECK(emio::format("{:a}", d) == "0x0.0000000000001p-1022");
+  }
+
+  std::snprintf(buffer, sizeof(buffer), "%.*a", 10, 4.2);
+  CHECK(emio::format("{:.10a}", 4.2) == buffer);
+
+  CHECK(emio::format("{:a}", -42.0) == "-0x1.5p+5");
+  CHECK(emio::format("{:A}", -42.0) == "-0X1.5P+5");
 
   CHECK(emio::format("{:f}", 9223372036854775807.0) == "9223372036854775808.000000");
 }
 
+TEST_CASE("format_double_hex") {
+  CHECK(emio::format("{:a}", 0.0) == "0x0p+0");
+  CHECK(emio::format("{:a}", -0.0) == "-0x0p+0");
+  CHECK(emio::format("{:.3a}", 0.0) == "0x0.000p+0");
+  CHECK(emio::format("{:a}", 1.0) == "0x1p+0");
+  CHECK(emio::format("{:#a}", 1.0) == "0x1.p+0");
+  CHECK(emio::format("{:.0a}", 1.0) == "0x1p+0");
+  CHECK(emio::format("{:#.0a}", 1.0) == "0x1.p+0");
+  CHECK(emio::format("{:a}", 0.5) == "0x1p-1");
+  CHECK(emio::format("{:.20a}", 1.0) == "0x1.00000000000000000000p+0");
+  CHECK(emio::format("{:.15A}", 0.1) == "0X1.999999999999A00P-4");
+
+  // Rounding (ties to even).
+  CHECK(emio::format("{:.0a}", 1.5) == "0x2p+0");
+  CHECK(emio::format("{:.0a}", 2.5) == "0x1p+1");
+  CHECK(emio::format("{:.1a}", 0x1.08p+0) == "0x1.0p+0");
+  CHECK(emio::format("{:.1a}", 0x1.18p+0) == "0x1.2p+0");
+  CHECK(emio::format("{:.1a}", 0x1.081p+0) == "0x1.1p+0");
+  CHECK(emio::format("{:.1a}", 0x1.f8p+0) == "0x2.0p+0");
+  CHECK(emio::format("{:.0a}", 0x0.fffffffffffffp-1022) == "0x1p-1022");
+
+  // Sign and padding.
+  CHECK(emio::format("{:+a}", 1.0) == "+0x1p+0");
+  CHECK(emio::format("{: a}", 1.0) == " 0x1p+0");
+  CHECK(emio::format("{:010a}", 1.0) == "0x00001p+0");
+  CHECK(emio::format("{:+010a}", 1.0) == "+0x0001p+0");
+  CHECK(emio::format("{:010A}", -1.0) == "-0X0001P+0");
+  CHECK(emio::format("{:^12a}", 1.0) == "   0x1p+0   ");
+  CHECK(emio::format("{:*<10a}", 1.0) == "0x1p+0****");
+  CHECK(emio::format("{:10a}", 1.0) == "    0x1p+0");
+
+  // Non-finite values.
+  CHECK(emio::format("{:a}", std::numeric_limits<double>::infinity()) == "inf");
+  CHECK(emio::format("{:A}", -std::numeric_limits<double>::infinity()) == "-INF");
+  CHECK(emio::format("{:a}", std::numeric_limits<double>::quiet_NaN()) == "nan");
+
+  SECTION("compile-time") {
+    constexpr bool success = [] {
+      emio::static_buffer<32> buf{};
+      emio::result<void> res = emio::format_to(buf, "{:a} {:.2A}", 42.0, 0.1);
+      return res && buf.view() == "0x1.5p+5 0X1.9AP-4";
+    }();
+    STATIC_CHECK(success);
+  }
+
+  SECTION("vs printf") {
+    std::array<char, 64> expected{};
+    uint64_t bits = 0x123456789abcdef;
+    for (size_t i = 0; i < 10'000; i++) {
+      bits = bits * 6364136223846793005U + 1442695040888963407U;  // LCG
+      const auto value = std::bit_cast<double>(bits);
+      if (!std::isfinite(value)) {
+        continue;
+      }
+      for (int precision = -1; precision <= 14; precision++) {
+        const int size = std::snprintf(expected.data(), expected.size(), "%.*a", precision, value);
+        REQUIRE(size > 0);
+        INFO(expected.data());
+        const emio::format_spec spec{.precision = precision};
+        const std::string str = precision < 0 ? emio::format("{:a}", value) : emio::format("{:a}", spec.with(value));
+        CHECK(str == std::string_view{expected.data(), static_cast<size_t>(size)});
+      }
+    }
+  }
+}
+
+TEST_CASE("format_double_high_precision") {
+  // The digits of these values and precisions exceed the small digit workspace.
+  static constexpr std::array values = {
+      1.0,
+      std::numbers::pi,
+      1e22,
+      std::numeric_limits<double>::min(),
+      std::numeric_limits<double>::max(),
+      std::numeric_limits<double>::lowest(),
+      std::numeric_limits<double>::denorm_min(),
+  };
+  struct high_precision_format {
+    std::string_view emio_format;
+    char type;
+    int precision;
+  };
+  static constexpr std::array<high_precision_format, 5> formats = {{
+      {"{:.64f}", 'f', 64},
+      {"{:.500f}", 'f', 500},
+      {"{:.1100f}", 'f', 1100},
+      {"{:.1100e}", 'e', 1100},
+      {"{:.1100}", 'g', 1100},
+  }};
+
+  std::array<char, 1500> expected{};
+  for (double value : values) {
+    for (const auto& [emio_format, type, precision] : formats) {
+      INFO(value << " formatted as " << emio_format);
+      int size{};
+      if (type == 'f') {
+        size = std::snprintf(expected.data(), expected.size(), "%.*f", precision, value);
+      } else if (type == 'e') {
+        size = std::snprintf(expected.data(), expected.size(), "%.*e", precision, value);
+      } else {
+        size = std::snprintf(expected.data(), expected.size(), "%.*g", precision, value);
+      }
+      REQUIRE(size > 0);
+      CHECK(emio::format(emio::runtime(emio_format), value) ==
+            std::string_view{expected.data(), static_cast<size_t>(size)});
+    }
+  }
+}
+
 TEST_CASE("precision_rounding") {
   CHECK(emio::format("{:.0f}", 0.0) == "0");
   CHECK(emio::format("{:.0f}", 0.01) == "0");
@@ -928,6 +1064,8 @@ TEST_CASE("validate_format_string") {
   CHECK(!validate_format_string<double>("{:.+1}"sv));
   CHECK(!validate_format_string<double>("{:.-1}"sv));
   CHECK(!validate_format_string<double>("{:x}"sv));
+  CHECK(validate_format_string<double>("{:a}"sv));
+  CHECK(validate_format_string<double>("{:#010.3A}"sv));
 
   CHECK(validate_format_string<bool>("{}"sv));
   CHECK(validate_format_string<bool>("{:d}"sv));
@@ -942,3 +1080,60 @@ TEST_CASE("validate_format_string") {
 
   CHECK(validate_format_string<void*>("{}"sv));
 }
+
+namespace {
+
+template <typename T>
+void check_tagged_format_arg(T value, std::string_view specs) {
+  using emio::detail::format::format_arg_trait;
+  using emio::detail::format::tagged_format_arg;
+
+  INFO("Specs: " << specs);
+
+  emio::memory_buffer<> expected_buf;
+  emio::writer expected_wtr{expected_buf};
+  emio::reader expected_rdr{specs};
+  const emio::detail::arg<emio::writer, format_arg_trait> expected_arg{value};
+  REQUIRE(expected_arg.process_arg(expected_wtr, expected_rdr));
+
+  emio::memory_buffer<> buf;
+  emio::writer wtr{buf};
+  emio::reader rdr{specs};
+  const tagged_format_arg arg{value};
+  REQUIRE(arg.process_arg(wtr, rdr));
+
+  CHECK(buf.view() == expected_buf.view());
+  CHECK(rdr.view_remaining() == expected_rdr.view_remaining());
+}
+
+struct tagged_custom {
+  int id;
+};
+
+}  // namespace
+
+template <>
+class emio::formatter<tagged_custom> : public emio::formatter<int> {
+ public:
+  constexpr result<void> format(writer& out, const tagged_custom& arg) const noexcept {
+    return formatter<int>::format(out, arg.id);
+  }
+};
+
+TEST_CASE("tagged_format_arg") {
+  // Test strategy:
+  // * Format core and custom types through the tagged union and through the virtual call of arg.
+  // Expected: Both dispatches produce the same output and consume the same format specs.
+
+  check_tagged_format_arg(true, "}");
+  check_tagged_format_arg('x', ":^5}");
+  check_tagged_format_arg(-42, ":+08}");
+  check_tagged_format_arg(42U, ":#x}");
+  check_tagged_format_arg(std::numeric_limits<int64_t>::min(), "}");
+  check_tagged_format_arg(std::numeric_limits<uint64_t>::max(), ":b}");
+  check_tagged_format_arg(3.25, ":.3e}");
+  check_tagged_format_arg("abc"sv, ":*>6}");
+  check_tagged_format_arg(nullptr, "}");
+  check_tagged_format_arg(reinterpret_cast<const void*>(0x1234), "}");
+  check_tagged_format_arg(tagged_custom{7}, ":03}");
+}
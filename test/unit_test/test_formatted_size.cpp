@@ -33,3 +33,95 @@ TEST_CASE("vformatted_size", "[formatted_size]") {
   CHECK(emio::vformatted_size(emio::make_format_args("{} {}", 1, 45)) == 4U);
   CHECK(emio::vformatted_size(emio::make_format_args(emio::runtime("{}"), 1, 45)) == emio::err::invalid_format);
 }
+
+namespace {
+
+template <emio::detail::format::fixed_string Str, typename T>
+void check_max_formatted_size(std::initializer_list<T> values, bool exact = false) {
+  constexpr size_t max_size = emio::max_formatted_size_v<Str, T>;
+  size_t largest = 0;
+  for (const T& value : values) {
+    const std::string str = emio::format(Str.view(), value);
+    INFO(Str.view() << " with " << str);
+    CHECK(str.size() <= max_size);
+    largest = std::max(largest, str.size());
+  }
+  if (exact) {
+    CHECK(largest == max_size);
+  }
+}
+
+}  // namespace
+
+TEST_CASE("max_formatted_size_v", "[formatted_size]") {
+  // Test strategy:
+  // * Determine the maximum output size of format strings with bounded types.
+  // * Format extreme values of these types.
+  // Expected: The output size is never larger than the maximum output size, which is exact for integral types.
+
+  STATIC_CHECK(emio::max_formatted_size_v<"abc"> == 3);
+  STATIC_CHECK(emio::max_formatted_size_v<"{{}}"> == 2);
+  STATIC_CHECK(emio::max_formatted_size_v<"{}", bool> == 5);
+  STATIC_CHECK(emio::max_formatted_size_v<"{:d}", bool> == 3);
+  STATIC_CHECK(emio::max_formatted_size_v<"{}", char> == 1);
+  STATIC_CHECK(emio::max_formatted_size_v<"{:?}", char> == 6);
+  STATIC_CHECK(emio::max_formatted_size_v<"{}", int32_t> == 11);
+  STATIC_CHECK(emio::max_formatted_size_v<"{}", uint32_t> == 10);
+  STATIC_CHECK(emio::max_formatted_size_v<"{}", int64_t> == 20);
+  STATIC_CHECK(emio::max_formatted_size_v<"{}", uint64_t> == 20);
+  STATIC_CHECK(emio::max_formatted_size_v<"{:#b}", int64_t> == 67);
+  STATIC_CHECK(emio::max_formatted_size_v<"{:#o}", uint32_t> == 12);
+  STATIC_CHECK(emio::max_formatted_size_v<"{:#X}", uint64_t> == 18);
+  STATIC_CHECK(emio::max_formatted_size_v<"{:30}", int32_t> == 30);
+  STATIC_CHECK(emio::max_formatted_size_v<"{}", std::nullptr_t> == 3);
+  STATIC_CHECK(emio::max_formatted_size_v<"{}", void*> == 2 + sizeof(void*) * 2);
+  STATIC_CHECK(emio::max_formatted_size_v<"{:.5}", std::string_view> == 5);
+  STATIC_CHECK(emio::max_formatted_size_v<"{:10.5}", std::string_view> == 10);
+  STATIC_CHECK(emio::max_formatted_size_v<"[{}, {:x}]", int32_t, uint8_t> == 1 + 11 + 2 + 8 + 1);
+  STATIC_CHECK(emio::max_formatted_size_v<"{1} {0}", char, bool> == 7);
+
+  SECTION("usable for a static_buffer") {
+    emio::static_buffer<emio::max_formatted_size_v<"{}: {}", int32_t, uint32_t>> buf;
+    REQUIRE(emio::format_to(buf, "{}: {}", std::numeric_limits<int32_t>::min(),
+                            std::numeric_limits<uint32_t>::max()));
+    CHECK(buf.view() == "-2147483648: 4294967295");
+  }
+
+  SECTION("integral types") {
+    constexpr auto i64_min = std::numeric_limits<int64_t>::min();
+    constexpr auto i64_max = std::numeric_limits<int64_t>::max();
+    check_max_formatted_size<"{}", int64_t>({i64_min, i64_max, 0}, true);
+    check_max_formatted_size<"{:+#b}", int64_t>({i64_min, i64_max, 0}, true);
+    check_max_formatted_size<"{:#o}", int64_t>({i64_min, i64_max, 0}, true);
+    check_max_formatted_size<"{: #x}", int64_t>({i64_min, i64_max, 0}, true);
+    check_max_formatted_size<"{:c}", int64_t>({65}, true);
+    check_max_formatted_size<"{:#b}", uint64_t>({std::numeric_limits<uint64_t>::max()}, true);
+  }
+
+  SECTION("floating-point types") {
+    constexpr double max = std::numeric_limits<double>::max();
+    constexpr double min = std::numeric_limits<double>::min();
+    constexpr double denorm_min = std::numeric_limits<double>::denorm_min();
+    constexpr double inf = std::numeric_limits<double>::infinity();
+    const std::initializer_list<double> values{
+        0.0, -0.0, 1.0, -max, max, -min, denorm_min, -1.2345678901234567e-5, -1.2345678901234567e15,
+        -1.2345678901234567e16, -0.1, 1.0 / 3.0, -inf, std::numeric_limits<double>::quiet_NaN()};
+    check_max_formatted_size<"{}", double>(values);
+    check_max_formatted_size<"{:#}", double>(values);
+    check_max_formatted_size<"{:.3}", double>(values);
+    check_max_formatted_size<"{:#.20}", double>(values);
+    check_max_formatted_size<"{:e}", double>(values);
+    check_max_formatted_size<"{:.0e}", double>(values);
+    check_max_formatted_size<"{:#.17E}", double>(values);
+    check_max_formatted_size<"{:f}", double>(values);
+    check_max_formatted_size<"{:.0f}", double>(values);
+    check_max_formatted_size<"{:#.30f}", double>(values);
+    check_max_formatted_size<"{:g}", double>(values);
+    check_max_formatted_size<"{:#.12G}", double>(values);
+    check_max_formatted_size<"{:a}", double>(values);
+    check_max_formatted_size<"{:#.2a}", double>(values);
+    check_max_formatted_size<"{:.20A}", double>(values);
+    check_max_formatted_size<"{}", float>({std::numeric_limits<float>::max(), -std::numeric_limits<float>::min(),
+                                            -std::numeric_limits<float>::denorm_min(), 1.0F / 3.0F});
+  }
+}
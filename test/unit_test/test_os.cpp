@@ -0,0 +1,679 @@
+// Unit under test.
+#include <emio/os.hpp>
+
+// Other includes.
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cstdio>
+#include <emio/format.hpp>
+#include <emio/scan.hpp>
+#include <fcntl.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::string read_all(int fd) {
+  std::string content;
+  std::array<char, 1024> buf{};
+  REQUIRE(::lseek(fd, 0, SEEK_SET) == 0);
+  while (true) {
+    const ssize_t cnt = ::read(fd, buf.data(), buf.size());
+    REQUIRE(cnt >= 0);
+    if (cnt == 0) {
+      return content;
+    }
+    content.append(buf.data(), static_cast<size_t>(cnt));
+  }
+}
+
+off_t written_size(int fd) {
+  return ::lseek(fd, 0, SEEK_END);
+}
+
+}  // namespace
+
+TEST_CASE("fd_buffer", "[os]") {
+  // Test strategy:
+  // * Construct a fd_buffer with the file descriptor of a temporary file.
+  // * Write into the buffer, flush (or not) and read out again.
+  // Expected: Everything is written to the file descriptor after flush.
+
+  std::FILE* tmpf = std::tmpfile();
+  REQUIRE(tmpf);
+  const int fd = fileno(tmpf);
+
+  emio::fd_buffer fd_buf{fd};
+
+  // Write area is limited.
+  CHECK(fd_buf.get_write_area_of(emio::default_fd_cache_size + 1) == emio::err::eof);
+
+  // Write into.
+  REQUIRE(emio::format_to(fd_buf, "{}", "abc"));
+  CHECK(written_size(fd) == 0);
+
+  // Flush.
+  REQUIRE(fd_buf.flush());
+  CHECK(read_all(fd) == "abc");
+
+  // Write into again.
+  REQUIRE(emio::format_to(fd_buf, "{}", 42));
+  CHECK(read_all(fd) == "abc");
+
+  REQUIRE(fd_buf.flush());
+  CHECK(read_all(fd) == "abc42");
+
+  // Flush without content.
+  REQUIRE(fd_buf.flush());
+  CHECK(read_all(fd) == "abc42");
+
+  std::fclose(tmpf);
+}
+
+TEST_CASE("fd_buffer writes whole pages", "[os]") {
+  // Test strategy:
+  // * Write more than the cache size into a fd_buffer in chunks which are not page aligned.
+  // Expected: Before the final flush, only whole pages are written. The remainder is written at flush.
+
+  std::FILE* tmpf = std::tmpfile();
+  REQUIRE(tmpf);
+  const int fd = fileno(tmpf);
+
+  emio::fd_buffer<2 * emio::page_size> fd_buf{fd};
+  std::string expected;
+
+  for (size_t i = 0; i < 4000; i++) {
+    const std::string chunk(i % 7 + 1, static_cast<char>('a' + i % 26));
+    REQUIRE(emio::format_to(fd_buf, "{}", chunk));
+    expected += chunk;
+    CHECK(written_size(fd) % static_cast<off_t>(emio::page_size) == 0);
+  }
+  CHECK(written_size(fd) > 0);
+  CHECK(static_cast<size_t>(written_size(fd)) < expected.size());
+
+  // A string larger than the cache is split.
+  const std::string large(5 * emio::page_size + 3, 'x');
+  REQUIRE(emio::format_to(fd_buf, "{}", large));
+  expected += large;
+  CHECK(written_size(fd) % static_cast<off_t>(emio::page_size) == 0);
+
+  REQUIRE(fd_buf.flush());
+  CHECK(read_all(fd) == expected);
+
+  std::fclose(tmpf);
+}
+
+TEST_CASE("fd_buffer with invalid file descriptor", "[os]") {
+  // Test strategy:
+  // * Construct a fd_buffer with an invalid file descriptor and flush.
+  // Expected: The flush fails with EOF.
+
+  emio::fd_buffer fd_buf{-1};
+  REQUIRE(emio::format_to(fd_buf, "abc"));
+  CHECK(fd_buf.flush() == emio::err::eof);
+}
+
+TEST_CASE("iovec_buffer", "[os]") {
+  // Test strategy:
+  // * Construct an iovec_buffer with the file descriptor of a temporary file.
+  // * Format short and long literals together with arguments, flush (or not) and read out again.
+  // Expected: Everything is written to the file descriptor after flush.
+
+  std::FILE* tmpf = std::tmpfile();
+  REQUIRE(tmpf);
+  const int fd = fileno(tmpf);
+
+  emio::iovec_buffer iov_buf{fd};
+  std::string expected;
+
+  REQUIRE(emio::format_to(iov_buf, "short {}", 1));
+  expected += "short 1";
+  REQUIRE(emio::format_to(iov_buf, "a long literal which is referenced instead of copied: {}|{}", 42, "abc"));
+  expected += "a long literal which is referenced instead of copied: 42|abc";
+  REQUIRE(emio::format_to(iov_buf, "{} a long literal which is referenced instead of copied", 'x'));
+  expected += "x a long literal which is referenced instead of copied";
+  REQUIRE(emio::format_to(iov_buf, "a long literal {{without}} arguments but with escape sequences"));
+  expected += "a long literal {without} arguments but with escape sequences";
+  REQUIRE(emio::format_to(iov_buf, emio::compile<"{}: a long compiled literal {{with}} escape sequences {}">, 1, 2));
+  expected += "1: a long compiled literal {with} escape sequences 2";
+  CHECK(written_size(fd) == 0);
+
+  REQUIRE(iov_buf.flush());
+  CHECK(read_all(fd) == expected);
+
+  // Flush without content.
+  REQUIRE(iov_buf.flush());
+  CHECK(read_all(fd) == expected);
+
+  std::fclose(tmpf);
+}
+
+TEST_CASE("iovec_buffer references literals", "[os]") {
+  // Test strategy:
+  // * Format with a long runtime format string into an iovec_buffer and modify the format string before flushing.
+  // Expected: The modification is visible in the output because the literal is referenced and not copied.
+
+  std::FILE* tmpf = std::tmpfile();
+  REQUIRE(tmpf);
+  const int fd = fileno(tmpf);
+
+  emio::iovec_buffer iov_buf{fd};
+
+  std::string format_str = "a long literal which is referenced instead of copied: {}";
+  REQUIRE(emio::format_to(iov_buf, emio::runtime(format_str), 1));
+  format_str[0] = 'A';
+  REQUIRE(iov_buf.flush());
+  CHECK(read_all(fd) == "A long literal which is referenced instead of copied: 1");
+
+  std::fclose(tmpf);
+}
+
+TEST_CASE("iovec_buffer with many segments", "[os]") {
+  // Test strategy:
+  // * Write more literals than segments and more formatted output than the cache size into an iovec_buffer.
+  // Expected: The segments are written in between and the output is complete after flush.
+
+  std::FILE* tmpf = std::tmpfile();
+  REQUIRE(tmpf);
+  const int fd = fileno(tmpf);
+
+  emio::iovec_buffer<16, 3> iov_buf{fd};
+  std::string expected;
+
+  for (size_t i = 0; i < 100; i++) {
+    REQUIRE(emio::format_to(iov_buf, "{} a long literal which is referenced instead of copied {}", i, i * 3));
+    expected += emio::format("{} a long literal which is referenced instead of copied {}", i, i * 3);
+  }
+  const std::string large(100, 'x');
+  REQUIRE(emio::format_to(iov_buf, "{}", large));
+  expected += large;
+  CHECK(written_size(fd) > 0);
+
+  REQUIRE(iov_buf.flush());
+  CHECK(read_all(fd) == expected);
+
+  std::fclose(tmpf);
+}
+
+TEST_CASE("iovec_buffer with invalid file descriptor", "[os]") {
+  // Test strategy:
+  // * Construct an iovec_buffer with an invalid file descriptor and flush.
+  // Expected: The flush fails with EOF.
+
+  emio::iovec_buffer iov_buf{-1};
+  REQUIRE(emio::format_to(iov_buf, "a long literal which is referenced instead of copied"));
+  CHECK(iov_buf.flush() == emio::err::eof);
+}
+
+TEST_CASE("mmap_file_buffer", "[os]") {
+  // Test strategy:
+  // * Construct a mmap_file_buffer with the file descriptor of a temporary file and a small grow size.
+  // * Write more than the grow size into the buffer and close it.
+  // Expected: The file has been extended in between and contains exactly the written content after close.
+
+  std::FILE* tmpf = std::tmpfile();
+  REQUIRE(tmpf);
+  const int fd = fileno(tmpf);
+
+  emio::mmap_file_buffer mmap_buf{fd, 1};
+  std::string expected;
+
+  CHECK(mmap_buf.size() == 0);
+  for (int i = 0; i < 1000; i++) {
+    REQUIRE(emio::format_to(mmap_buf, "{} - {}\n", i, i * 1.5));
+    expected += emio::format("{} - {}\n", i, i * 1.5);
+  }
+  CHECK(mmap_buf.size() == expected.size());
+  CHECK(written_size(fd) % static_cast<off_t>(emio::page_size) == 0);
+  CHECK(static_cast<size_t>(written_size(fd)) >= expected.size());
+
+  // Larger than the grow size.
+  const std::string large(3 * emio::page_size + 1, 'x');
+  REQUIRE(emio::format_to(mmap_buf, "{}", large));
+  expected += large;
+
+  REQUIRE(mmap_buf.close());
+  CHECK(static_cast<size_t>(written_size(fd)) == expected.size());
+  CHECK(read_all(fd) == expected);
+
+  SECTION("append after close") {
+    REQUIRE(emio::format_to(mmap_buf, "abc"));
+    REQUIRE(mmap_buf.close());
+    CHECK(read_all(fd) == expected + "abc");
+  }
+  SECTION("close twice") {
+    REQUIRE(mmap_buf.close());
+    CHECK(read_all(fd) == expected);
+  }
+
+  std::fclose(tmpf);
+}
+
+TEST_CASE("mmap_file_buffer closes on destruction", "[os]") {
+  // Test strategy:
+  // * Write into a mmap_file_buffer with existing content in the file and destruct the buffer without closing it.
+  // Expected: The previous content is replaced and the file is truncated to the written size.
+
+  std::FILE* tmpf = std::tmpfile();
+  REQUIRE(tmpf);
+  const int fd = fileno(tmpf);
+  REQUIRE(emio::detail::write_all(fd, "previous content", 16));
+
+  {
+    emio::mmap_file_buffer mmap_buf{fd};
+    REQUIRE(emio::format_to(mmap_buf, "new {}", 42));
+  }
+  CHECK(read_all(fd) == "new 42");
+
+  std::fclose(tmpf);
+}
+
+TEST_CASE("mmap_file_buffer with invalid file descriptor", "[os]") {
+  // Test strategy:
+  // * Construct a mmap_file_buffer with an invalid file descriptor and write into it.
+  // Expected: The write fails with EOF.
+
+  emio::mmap_file_buffer mmap_buf{-1};
+  CHECK(emio::format_to(mmap_buf, "abc") == emio::err::eof);
+  CHECK(mmap_buf.close() == emio::err::eof);
+}
+
+namespace {
+
+template <size_t SlotCount, size_t SlotSize>
+concept valid_ring_buffer_sink = requires { typename emio::ring_buffer_sink<SlotCount, SlotSize>; };
+
+}  // namespace
+
+TEST_CASE("ring_buffer_sink template arguments", "[os]") {
+  // Test strategy:
+  // * Check which slot counts and slot sizes are accepted by ring_buffer_sink.
+  // Expected: The slot count must be a power of two and at least two. The slot size must not be zero.
+  //           With a single slot, the committed and the drained sequence of a slot could not be told apart.
+
+  STATIC_CHECK(valid_ring_buffer_sink<2, 1>);
+  STATIC_CHECK(valid_ring_buffer_sink<4, 16>);
+  STATIC_CHECK(!valid_ring_buffer_sink<0, 16>);
+  STATIC_CHECK(!valid_ring_buffer_sink<1, 16>);
+  STATIC_CHECK(!valid_ring_buffer_sink<3, 16>);
+  STATIC_CHECK(!valid_ring_buffer_sink<4, 0>);
+}
+
+TEST_CASE("ring_buffer_sink", "[os]") {
+  // Test strategy:
+  // * Reserve slots of a ring_buffer_sink, format into them and commit them in different orders.
+  // * Drain the ring buffer into a temporary file.
+  // Expected: The committed records are written in reservation order. Drain stops at the first uncommitted record.
+
+  std::FILE* tmpf = std::tmpfile();
+  REQUIRE(tmpf);
+  const int fd = fileno(tmpf);
+
+  emio::ring_buffer_sink<4, 16> ring;
+
+  SECTION("commit in order") {
+    for (int i = 0; i < 3; i++) {
+      auto slot = ring.reserve();
+      REQUIRE(emio::format_to(slot, "record {}\n", i));
+    }
+    CHECK(ring.drain_to(fd) == 3U);
+    CHECK(ring.drain_to(fd) == 0U);
+    CHECK(read_all(fd) == "record 0\nrecord 1\nrecord 2\n");
+  }
+  SECTION("commit out of order") {
+    auto first = ring.reserve();
+    auto second = ring.reserve();
+    REQUIRE(emio::format_to(second, "second\n"));
+    second.commit();
+    CHECK(ring.drain_to(fd) == 0U);
+
+    REQUIRE(emio::format_to(first, "first\n"));
+    first.commit();
+    CHECK(ring.drain_to(fd) == 2U);
+    CHECK(read_all(fd) == "first\nsecond\n");
+
+    // Nothing can be written after commit.
+    CHECK(emio::format_to(first, "x") == emio::err::eof);
+  }
+  SECTION("wrap around") {
+    std::string expected;
+    for (int i = 0; i < 10; i++) {
+      {
+        auto slot = ring.reserve();
+        REQUIRE(emio::format_to(slot, "{},", i));
+      }
+      expected += std::to_string(i) + ',';
+      if (i % 3 == 2) {
+        CHECK(ring.drain_to(fd) == 3U);
+      }
+    }
+    CHECK(ring.drain_to(fd) == 1U);
+    CHECK(read_all(fd) == expected);
+  }
+  SECTION("record larger than a slot") {
+    {
+      auto slot = ring.reserve();
+      CHECK(emio::format_to(slot, "{}", "0123456789abcdefghij") == emio::err::eof);
+    }
+    {
+      auto slot = ring.reserve();
+      REQUIRE(emio::format_to(slot, "|"));
+    }
+    CHECK(ring.drain_to(fd) == 2U);
+    CHECK(read_all(fd) == "0123456789abcdef|");
+  }
+  SECTION("invalid file descriptor") {
+    for (int i = 0; i < 4; i++) {
+      auto slot = ring.reserve();
+      REQUIRE(emio::format_to(slot, "{}", i));
+    }
+    CHECK(ring.drain_to(-1) == emio::err::eof);
+    // The slots are released anyway.
+    {
+      auto slot = ring.reserve();
+      REQUIRE(emio::format_to(slot, "next"));
+    }
+    CHECK(ring.drain_to(fd) == 1U);
+    CHECK(read_all(fd) == "next");
+  }
+
+  std::fclose(tmpf);
+}
+
+TEST_CASE("ring_buffer_sink with multiple producers", "[os]") {
+  // Test strategy:
+  // * Let multiple producer threads format records into a small ring_buffer_sink while a consumer thread drains it.
+  // Expected: Every record is written once and the records of each producer keep their order.
+
+  constexpr int producer_cnt = 8;
+  constexpr int records_per_producer = 2000;
+
+  std::FILE* tmpf = std::tmpfile();
+  REQUIRE(tmpf);
+  const int fd = fileno(tmpf);
+
+  const auto ring = std::make_unique<emio::ring_buffer_sink<16, 32>>();
+  std::atomic<bool> producing{true};
+  std::thread consumer{[&] {
+    while (producing.load()) {
+      if (ring->drain_to(fd).value() == 0) {
+        std::this_thread::yield();
+      }
+    }
+    ring->drain_to(fd).value();
+  }};
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < producer_cnt; p++) {
+    producers.emplace_back([&ring, p] {
+      for (int i = 0; i < records_per_producer; i++) {
+        auto slot = ring->reserve();
+        emio::format_to(slot, "{} {}\n", p, i).value();
+      }
+    });
+  }
+  for (std::thread& producer : producers) {
+    producer.join();
+  }
+  producing.store(false);
+  consumer.join();
+
+  std::vector<int> next_record(producer_cnt);
+  emio::result<emio::mmap_file> file = emio::mmap_file::map(fd);
+  REQUIRE(file);
+  for (const std::string_view line : file->lines()) {
+    int p{};
+    int i{};
+    REQUIRE(emio::scan(line, "{} {}", p, i));
+    REQUIRE(p < producer_cnt);
+    CHECK(i == next_record[static_cast<size_t>(p)]++);
+  }
+  CHECK(std::ranges::all_of(next_record, [](int cnt) {
+    return cnt == records_per_producer;
+  }));
+
+  std::fclose(tmpf);
+}
+
+TEST_CASE("async_fd_buffer", "[os]") {
+  // Test strategy:
+  // * Construct an async_fd_buffer with the file descriptor of a temporary file and a long flush interval.
+  // * Write into the buffer, flush (or destroy it) and read out again.
+  // Expected: Everything is written to the file descriptor after flush or destruction.
+
+  std::FILE* tmpf = std::tmpfile();
+  REQUIRE(tmpf);
+  const int fd = fileno(tmpf);
+
+  {
+    emio::async_fd_buffer fd_buf{fd, std::chrono::hours{1}};
+
+    // Write into.
+    REQUIRE(emio::format_to(fd_buf, "{}", "abc"));
+    CHECK(written_size(fd) == 0);
+
+    // Flush.
+    REQUIRE(fd_buf.flush());
+    CHECK(read_all(fd) == "abc");
+
+    // Flush without content.
+    REQUIRE(fd_buf.flush());
+    CHECK(read_all(fd) == "abc");
+
+    // Write into again.
+    REQUIRE(emio::format_to(fd_buf, "{}", 42));
+  }
+  CHECK(read_all(fd) == "abc42");
+
+  std::fclose(tmpf);
+}
+
+TEST_CASE("async_fd_buffer swaps full buffers", "[os]") {
+  // Test strategy:
+  // * Write more than twice the buffer size into an async_fd_buffer in chunks which are not page aligned.
+  // Expected: The buffers are swapped while writing and everything is written in order after flush.
+
+  std::FILE* tmpf = std::tmpfile();
+  REQUIRE(tmpf);
+  const int fd = fileno(tmpf);
+
+  const auto fd_buf = std::make_unique<emio::async_fd_buffer<2 * emio::page_size>>(fd, std::chrono::hours{1});
+  std::string expected;
+
+  for (size_t i = 0; i < 4000; i++) {
+    const std::string chunk(i % 7 + 1, static_cast<char>('a' + i % 26));
+    REQUIRE(emio::format_to(*fd_buf, "{}", chunk));
+    expected += chunk;
+  }
+
+  // A string larger than a buffer is split.
+  const std::string large(5 * emio::page_size + 3, 'x');
+  REQUIRE(emio::format_to(*fd_buf, "{}", large));
+  expected += large;
+
+  // A request which doesn't fit into the remaining buffer is served by the next one.
+  REQUIRE(emio::format_to(*fd_buf, "{}", std::string(2 * emio::page_size - 10, 'y')));
+  expected += std::string(2 * emio::page_size - 10, 'y');
+  const emio::result<std::span<char>> area = fd_buf->get_write_area_of(2 * emio::page_size);
+  REQUIRE(area);
+  std::fill(area->begin(), area->end(), 'z');
+  expected += std::string(2 * emio::page_size, 'z');
+
+  CHECK(written_size(fd) > 0);
+  REQUIRE(fd_buf->flush());
+  CHECK(read_all(fd) == expected);
+
+  std::fclose(tmpf);
+}
+
+TEST_CASE("async_fd_buffer with flush interval", "[os]") {
+  // Test strategy:
+  // * Fill a page of an async_fd_buffer and write more after its flush interval has elapsed.
+  // Expected: The filled page is written without flush although the buffer isn't full.
+
+  std::FILE* tmpf = std::tmpfile();
+  REQUIRE(tmpf);
+  const int fd = fileno(tmpf);
+
+  const auto fd_buf = std::make_unique<emio::async_fd_buffer<>>(fd, std::chrono::milliseconds{1});
+  std::this_thread::sleep_for(std::chrono::milliseconds{2});
+  REQUIRE(emio::format_to(*fd_buf, "{}", std::string(emio::page_size, 'x')));
+  REQUIRE(emio::format_to(*fd_buf, "x"));
+
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+  while (written_size(fd) == 0 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::yield();
+  }
+  CHECK(written_size(fd) == static_cast<off_t>(emio::page_size));
+
+  REQUIRE(fd_buf->flush());
+  CHECK(read_all(fd) == std::string(emio::page_size + 1, 'x'));
+
+  std::fclose(tmpf);
+}
+
+TEST_CASE("async_fd_buffer with invalid file descriptor", "[os]") {
+  // Test strategy:
+  // * Construct an async_fd_buffer with an invalid file descriptor and flush.
+  // Expected: The flush fails with EOF. The error is reported once.
+
+  emio::async_fd_buffer fd_buf{-1};
+  REQUIRE(emio::format_to(fd_buf, "abc"));
+  CHECK(fd_buf.flush() == emio::err::eof);
+  CHECK(fd_buf.flush());
+}
+
+TEST_CASE("fd_stream_reader", "[os]") {
+  // Test strategy:
+  // * Write lines into a pipe and read them with a fd_stream_reader.
+  // Expected: All lines are read.
+
+  std::array<int, 2> fds{};
+  REQUIRE(::pipe(fds.data()) == 0);
+  const std::string_view input = "line 1\nline 2\nline 3";
+  REQUIRE(emio::detail::write_all(fds[1], input.data(), input.size()));
+  ::close(fds[1]);
+
+  emio::fd_stream_reader<16> rdr{fds[0]};
+  int value{};
+  for (int i = 1; i <= 3; i++) {
+    REQUIRE(emio::scan_from(rdr, "line {}", value));
+    CHECK(value == i);
+    static_cast<void>(rdr.read_line());
+  }
+  CHECK(rdr.eof());
+
+  ::close(fds[0]);
+}
+
+TEST_CASE("fd_stream_reader doesn't wait for input after a complete result", "[os]") {
+  // Test strategy:
+  // * Write input into a non-blocking pipe which stays open and read it with a fd_stream_reader.
+  // * The reads end exactly at the last available byte or fill the cache exactly.
+  // Expected: The reads succeed without requesting more input (which would fail with EAGAIN). Reads which need more
+  //           input to decide wait for it.
+
+  std::array<int, 2> fds{};
+  REQUIRE(::pipe(fds.data()) == 0);
+  REQUIRE(::fcntl(fds[0], F_SETFL, O_NONBLOCK) == 0);
+  const auto write_input = [&](std::string_view input) {
+    REQUIRE(emio::detail::write_all(fds[1], input.data(), input.size()));
+  };
+
+  emio::fd_stream_reader<8> rdr{fds[0]};
+
+  write_input("line\n");
+  CHECK(rdr.read_line() == "line");
+
+  write_input("ab");
+  CHECK(rdr.read_char() == 'a');
+  CHECK(rdr.read_char() == 'b');
+
+  write_input("x=");
+  CHECK(rdr.read_until_char('=', {.include_delimiter = true}) == "x=");
+
+  write_input("01234567");
+  CHECK(rdr.read_n_chars(8) == "01234567");
+
+  write_input("12");
+  CHECK(rdr.read_if_match_str("12") == "12");
+
+  write_input("4");
+  CHECK(rdr.read_until_char('\n') == emio::err::eof);  // Requires more input, which isn't available yet.
+  CHECK(rdr.parse_int<int>() == emio::err::eof);         // Could be continued by more digits.
+  write_input("2\nend");
+  CHECK(rdr.parse_int<int>() == 42);
+  CHECK(rdr.read_char() == '\n');
+
+  ::close(fds[1]);
+  CHECK(rdr.read_line() == "end");
+  CHECK(rdr.eof());
+
+  ::close(fds[0]);
+}
+
+TEST_CASE("mmap_file", "[os]") {
+  // Test strategy:
+  // * Map a temporary file and read, scan and iterate over its lines.
+  // Expected: The content is the same as written and scanned strings point into the mapping.
+
+  std::FILE* tmpf = std::tmpfile();
+  REQUIRE(tmpf);
+  const int fd = fileno(tmpf);
+  const std::string_view content = "1 first\n2 second\n\n3 third";
+  REQUIRE(emio::detail::write_all(fd, content.data(), content.size()));
+
+  emio::result<emio::mmap_file> file = emio::mmap_file::map(fd);
+  REQUIRE(file);
+  std::fclose(tmpf);  // Mapping stays valid.
+
+  CHECK(file->view() == content);
+
+  SECTION("scan") {
+    emio::reader rdr = file->get_reader();
+    int i{};
+    std::string_view str;
+    REQUIRE(emio::scan_from(rdr, "{} {}\n", i, str));
+    CHECK(i == 1);
+    CHECK(str == "first");
+    CHECK(str.data() == file->view().data() + 2);
+  }
+  SECTION("lines") {
+    std::vector<std::string_view> lines;
+    for (std::string_view line : file->lines()) {
+      CHECK(line.data() >= file->view().data());
+      CHECK(line.data() + line.size() <= file->view().data() + file->view().size());
+      lines.push_back(line);
+    }
+    CHECK(lines == std::vector<std::string_view>{"1 first", "2 second", "", "3 third"});
+  }
+  SECTION("records") {
+    std::vector<std::string_view> records;
+    std::ranges::copy(file->records(' '), std::back_inserter(records));
+    CHECK(records == std::vector<std::string_view>{"1", "first\n2", "second\n\n3", "third"});
+  }
+  SECTION("move") {
+    emio::mmap_file other = std::move(*file);
+    CHECK(other.view() == content);
+    CHECK(file->view().empty());  // NOLINT(bugprone-use-after-move): moved-from state is defined
+  }
+}
+
+TEST_CASE("mmap_file of empty file", "[os]") {
+  std::FILE* tmpf = std::tmpfile();
+  REQUIRE(tmpf);
+
+  emio::result<emio::mmap_file> file = emio::mmap_file::map(fileno(tmpf));
+  REQUIRE(file);
+  CHECK(file->view().empty());
+  CHECK(file->lines().begin() == std::default_sentinel);
+
+  std::fclose(tmpf);
+}
+
+TEST_CASE("mmap_file with invalid file descriptor", "[os]") {
+  CHECK(emio::mmap_file::map(-1) == emio::err::eof);
+}
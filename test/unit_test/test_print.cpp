@@ -3,6 +3,10 @@
 
 // Other includes.
 #include <catch2/catch_test_macros.hpp>
+#include <emio/scan.hpp>
+#include <string>
+#include <thread>
+#include <vector>
 
 TEST_CASE("print/println") {
   std::FILE* no_file{};
@@ -37,3 +41,118 @@ TEST_CASE("print/println to temporary file") {
   CHECK(std::fgets(buf.data(), buf.size(), tmpf) != nullptr);
   CHECK(std::string_view{buf.data(), 4} == "abc\n");
 }
+
+namespace {
+
+struct nested_print {
+  std::FILE* file;
+};
+
+}  // namespace
+
+template <>
+class emio::formatter<nested_print> : public emio::formatter<std::string_view> {
+ public:
+  emio::result<void> format(emio::writer& out, const nested_print& arg) const noexcept {
+    EMIO_TRYV(emio::println_atomic(arg.file, "nested"));
+    return emio::formatter<std::string_view>::format(out, "outer");
+  }
+};
+
+TEST_CASE("print_atomic/println_atomic") {
+  std::FILE* no_file{};
+
+  CHECK(emio::print_atomic("hello {}", "world"));
+  CHECK(emio::print_atomic(emio::runtime("hello {}"), "world"));
+  CHECK(emio::print_atomic(stderr, "hello {}", "world"));
+  CHECK(emio::print_atomic(stderr, emio::runtime("hello {}"), "world"));
+  CHECK(emio::print_atomic(no_file, emio::runtime("hello {}"), "world") == emio::err::invalid_data);
+
+  CHECK(emio::println_atomic("hello {}", "world"));
+  CHECK(emio::println_atomic(emio::runtime("hello {}"), "world"));
+  CHECK(emio::println_atomic(stderr, "hello {}", "world"));
+  CHECK(emio::println_atomic(stderr, emio::runtime("hello {}"), "world"));
+  CHECK(emio::println_atomic(no_file, emio::runtime("hello {}"), "world") == emio::err::invalid_data);
+}
+
+TEST_CASE("println_atomic from multiple threads") {
+  // Test strategy:
+  // * Print lines longer than the internal cache of a file_buffer from multiple threads into the same file.
+  // Expected: Every line is written as a whole and no line is interleaved with another one.
+
+  constexpr int thread_cnt = 8;
+  constexpr int lines_per_thread = 500;
+  const std::string padding(300, '.');
+
+  std::FILE* tmpf = std::tmpfile();
+  REQUIRE(tmpf);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < thread_cnt; t++) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < lines_per_thread; i++) {
+        emio::println_atomic(tmpf, "{} {} {} end", t, padding, i).value();
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  std::rewind(tmpf);
+  const std::string pattern = "{} " + padding + " {} end\n";
+  std::vector<int> next_line(thread_cnt);
+  std::array<char, 512> buf{};
+  int line_cnt = 0;
+  while (std::fgets(buf.data(), buf.size(), tmpf) != nullptr) {
+    const std::string_view line{buf.data()};
+    int t{};
+    int i{};
+    REQUIRE(emio::scan(line, emio::runtime(pattern), t, i));
+    REQUIRE(t < thread_cnt);
+    CHECK(i == next_line[static_cast<size_t>(t)]++);
+    line_cnt++;
+  }
+  CHECK(line_cnt == thread_cnt * lines_per_thread);
+
+  std::fclose(tmpf);
+}
+
+TEST_CASE("print_atomic from inside of a formatter") {
+  // Test strategy:
+  // * Print an argument whose formatter prints itself into the same file.
+  // Expected: The nested print doesn't corrupt the output of the outer print.
+
+  std::FILE* tmpf = std::tmpfile();
+  REQUIRE(tmpf);
+
+  CHECK(emio::println_atomic(tmpf, "{} {}", nested_print{tmpf}, std::string(1000, 'x')));
+  CHECK(emio::println_atomic(tmpf, "last"));
+
+  std::rewind(tmpf);
+  std::string content(2000, '\0');
+  content.resize(std::fread(content.data(), 1, content.size(), tmpf));
+  CHECK(content == "nested\nouter " + std::string(1000, 'x') + "\nlast\n");
+
+  std::fclose(tmpf);
+}
+
+TEST_CASE("print_atomic a large output") {
+  // Test strategy:
+  // * Print an output larger than the thread-local buffer is retained and print again.
+  // Expected: Both outputs are written completely.
+
+  std::FILE* tmpf = std::tmpfile();
+  REQUIRE(tmpf);
+
+  const std::string large(100'000, 'y');
+  CHECK(emio::print_atomic(tmpf, "{}", large));
+  CHECK(emio::print_atomic(tmpf, "z"));
+
+  std::rewind(tmpf);
+  std::string content(large.size() + 2, '\0');
+  content.resize(std::fread(content.data(), 1, content.size(), tmpf));
+  CHECK(content == large + 'z');
+
+  std::fclose(tmpf);
+}
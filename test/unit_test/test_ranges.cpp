@@ -15,12 +15,14 @@
 // Other includes.
 #include <fmt/ranges.h>
 
+#include <array>
 #include <catch2/catch_test_macros.hpp>
 #include <emio/format.hpp>
 #include <list>
 #include <map>
 #include <queue>
 #include <set>
+#include <span>
 #include <stack>
 #include <string>
 #include <vector>
@@ -181,6 +183,59 @@ TEST_CASE("format_to", "[ranges]") {
   CHECK(std::string_view{buf} == "[1, 2, 3]");
 }
 
+TEST_CASE("format contiguous arithmetic ranges in bulk", "[ranges]") {
+  // Test strategy:
+  // * Format contiguous ranges of arithmetic types, which are formatted in bulk, into different buffers.
+  // Expected: The output is the same as formatting each element on its own.
+
+  std::vector<int32_t> ints(1000);
+  for (size_t i = 0; i < ints.size(); i++) {
+    ints[i] = static_cast<int32_t>(i * i) * (i % 2 == 0 ? 1 : -1);
+  }
+  const auto join = [](const auto& range, emio::runtime_string element_format) {
+    std::string expected = "[";
+    for (const auto& e : range) {
+      if (expected.size() != 1) {
+        expected += ", ";
+      }
+      expected += emio::format(element_format, e).value();
+    }
+    return expected + "]";
+  };
+
+  SECTION("integers") {
+    CHECK(emio::format("{}", ints) == join(ints, emio::runtime("{}")));
+    CHECK(emio::format("{::>+8x}", ints) == join(ints, emio::runtime("{:>+8x}")));
+    CHECK(emio::format("{}", std::span<const int32_t, 3>{ints.data(), 3}) == "[0, -1, 4]");
+  }
+  SECTION("floating-points") {
+    std::vector<double> doubles(100);
+    for (size_t i = 0; i < doubles.size(); i++) {
+      doubles[i] = static_cast<double>(i) / 7.0 - 3.0;
+    }
+    CHECK(emio::format("{}", doubles) == join(doubles, emio::runtime("{}")));
+    CHECK(emio::format("{::.3e}", doubles) == join(doubles, emio::runtime("{:.3e}")));
+    CHECK(emio::format("{::.2f}", doubles) == join(doubles, emio::runtime("{:.2f}")));
+  }
+  SECTION("chars and bools") {
+    CHECK(emio::format("{}", std::vector<char>{'a', '\n'}) == "['a', '\\n']");
+    CHECK(emio::format("{}", std::array<bool, 2>{true, false}) == "[true, false]");
+  }
+  SECTION("buffer with small cache") {
+    std::list<char> out;
+    emio::iterator_buffer<std::back_insert_iterator<std::list<char>>, 16> buf{std::back_inserter(out)};
+    REQUIRE(emio::format_to(buf, "{}|{::20}", ints, std::vector<int>{1, 2}));
+    REQUIRE(buf.flush());
+    CHECK(std::string(out.begin(), out.end()) == join(ints, emio::runtime("{}")) + "|[" + std::string(19, ' ') +
+                                                     "1, " + std::string(19, ' ') + "2]");
+  }
+  SECTION("buffer too small") {
+    emio::static_buffer<20> buf{};
+    CHECK(emio::format_to(buf, "{}", ints) == emio::err::eof);
+    CHECK(buf.view() == "[0, -1, 4, -9, 16, ");
+  }
+}
+
 // struct path_like {
 //   const path_like* begin() const;
 //   const path_like* end() const;
@@ -4,6 +4,9 @@
 // Other includes.
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
+#include <cmath>
+#include <emio/format.hpp>
+#include <string>
 
 #include "integer_ranges.hpp"
 
@@ -168,6 +171,149 @@ TEST_CASE("reader::parse_int", "[reader]") {
   }
 }
 
+TEST_CASE("reader::parse_int with many digits", "[reader]") {
+  // Test strategy:
+  // * Call parse_int with decimal and hexadecimal inputs of different lengths (parsed in chunks of 8 digits), leading
+  //   zeros and trailing chars.
+  // Expected: The results are the same as parsing char by char.
+
+  SECTION("decimal") {
+    CHECK(emio::reader{"12345678"}.parse_int<uint32_t>() == 12345678U);
+    CHECK(emio::reader{"123456789"}.parse_int<uint32_t>() == 123456789U);
+    CHECK(emio::reader{"1234567890123456789"}.parse_int<int64_t>() == 1234567890123456789);
+    CHECK(emio::reader{"-1234567890123456789x"}.parse_int<int64_t>() == -1234567890123456789);
+    CHECK(emio::reader{"18446744073709551615"}.parse_int<uint64_t>() == std::numeric_limits<uint64_t>::max());
+    CHECK(emio::reader{"18446744073709551616"}.parse_int<uint64_t>() == emio::err::out_of_range);
+    CHECK(emio::reader{"99999999999999999999999"}.parse_int<uint64_t>() == emio::err::out_of_range);
+    CHECK(emio::reader{"00000000000000000000000042"}.parse_int<int8_t>() == 42);
+    CHECK(emio::reader{"-0000000000000000000000128"}.parse_int<int8_t>() == -128);
+    CHECK(emio::reader{"-0000000000000000000000129"}.parse_int<int8_t>() == emio::err::out_of_range);
+    CHECK(emio::reader{"12\x80"}.parse_int<int>() == 12);
+    CHECK(emio::reader{"12:3"}.parse_int<int>() == 12);
+    CHECK(emio::reader{"-0"}.parse_int<unsigned>() == emio::err::out_of_range);
+  }
+  SECTION("hexadecimal") {
+    CHECK(emio::reader{"abcdef01"}.parse_int<uint32_t>(16) == 0xabcdef01U);
+    CHECK(emio::reader{"ABCDEF012"}.parse_int<uint64_t>(16) == 0xABCDEF012U);
+    CHECK(emio::reader{"fFfFfFfFfFfFfFfF"}.parse_int<uint64_t>(16) == std::numeric_limits<uint64_t>::max());
+    CHECK(emio::reader{"10000000000000000"}.parse_int<uint64_t>(16) == emio::err::out_of_range);
+    CHECK(emio::reader{"00000000000000000000ff"}.parse_int<uint8_t>(16) == 255);
+    CHECK(emio::reader{"-80"}.parse_int<int8_t>(16) == -128);
+    CHECK(emio::reader{"-81"}.parse_int<int8_t>(16) == emio::err::out_of_range);
+    CHECK(emio::reader{"12:3"}.parse_int<int>(16) == 0x12);
+    CHECK(emio::reader{"1@"}.parse_int<int>(16) == 1);
+    CHECK(emio::reader{"fg"}.parse_int<int>(16) == 0xf);
+    CHECK(emio::reader{"FG"}.parse_int<int>(16) == 0xF);
+    CHECK(emio::reader{"1`"}.parse_int<int>(16) == 1);
+  }
+  SECTION("read position") {
+    emio::reader rdr{"123456789012,abcdef0123456789"};
+    CHECK(rdr.parse_int<uint64_t>() == 123456789012U);
+    CHECK(rdr.read_char() == ',');
+    CHECK(rdr.parse_int<uint64_t>(16) == 0xabcdef0123456789U);
+    CHECK(rdr.eof());
+  }
+  SECTION("round trip") {
+    const auto round_trip = []<typename T>(T value) {
+      for (const int base : {10, 16}) {
+        const std::string str = base == 10 ? emio::format("{}", value) : emio::format("{:x}", value);
+        INFO(str);
+        CHECK(emio::reader{str}.parse_int<T>(base) == value);
+      }
+    };
+    uint64_t value = 1;
+    for (int i = 0; i < 64; i++) {
+      round_trip(value);
+      round_trip(value - 1);
+      round_trip(static_cast<int64_t>(value));
+      round_trip(-static_cast<int64_t>(value >> 1));
+      round_trip(static_cast<uint32_t>(value));
+      round_trip(static_cast<int16_t>(value));
+      value <<= 1;
+    }
+  }
+}
+
+TEST_CASE("reader::parse_float", "[reader]") {
+  SECTION("fixed and scientific notation") {
+    CHECK(emio::reader{"0"}.parse_float<double>() == 0.0);
+    CHECK(emio::reader{"42"}.parse_float<double>() == 42.0);
+    CHECK(emio::reader{"-3.25"}.parse_float<double>() == -3.25);
+    CHECK(emio::reader{"+.5"}.parse_float<double>() == 0.5);
+    CHECK(emio::reader{"5."}.parse_float<double>() == 5.0);
+    CHECK(emio::reader{"0.1"}.parse_float<double>() == 0.1);
+    CHECK(emio::reader{"1e3"}.parse_float<double>() == 1e3);
+    CHECK(emio::reader{"1.5E-3"}.parse_float<double>() == 1.5e-3);
+    CHECK(emio::reader{"2.5e+10"}.parse_float<double>() == 2.5e10);
+    CHECK(emio::reader{"0.1"}.parse_float<float>() == 0.1F);
+    CHECK(emio::reader{"3.4028234e38"}.parse_float<float>() == std::numeric_limits<float>::max());
+  }
+
+  SECTION("correct rounding") {
+    CHECK(emio::reader{"1.7976931348623157e308"}.parse_float<double>() == std::numeric_limits<double>::max());
+    CHECK(emio::reader{"2.2250738585072014e-308"}.parse_float<double>() == std::numeric_limits<double>::min());
+    CHECK(emio::reader{"4.9e-324"}.parse_float<double>() == std::numeric_limits<double>::denorm_min());
+    CHECK(emio::reader{"2.4703282292062328e-324"}.parse_float<double>() == std::numeric_limits<double>::denorm_min());
+    CHECK(emio::reader{"2.4703282292062327e-324"}.parse_float<double>() == 0.0);
+    CHECK(emio::reader{"1e-400"}.parse_float<double>() == 0.0);
+    CHECK(emio::reader{"123456789012345678901234567890"}.parse_float<double>() == 123456789012345678901234567890.0);
+    CHECK(emio::reader{"9007199254740993"}.parse_float<double>() == 9007199254740992.0);
+    CHECK(emio::reader{"9007199254740993.0000000000000000000000001"}.parse_float<double>() == 9007199254740994.0);
+    // Exactly between 1 and its successor.
+    CHECK(emio::reader{"1.00000000000000011102230246251565404236316680908203125"}.parse_float<double>() == 1.0);
+    CHECK(emio::reader{"1.000000000000000111022302462515654042363166809082031251"}.parse_float<double>() ==
+          std::nextafter(1.0, 2.0));
+  }
+
+  SECTION("special values") {
+    CHECK(emio::reader{"inf"}.parse_float<double>() == std::numeric_limits<double>::infinity());
+    CHECK(emio::reader{"-Infinity"}.parse_float<double>() == -std::numeric_limits<double>::infinity());
+    CHECK(emio::reader{"INF"}.parse_float<float>() == std::numeric_limits<float>::infinity());
+    const emio::result<double> nan = emio::reader{"NaN"}.parse_float<double>();
+    REQUIRE(nan);
+    CHECK(std::isnan(nan.value()));
+  }
+
+  SECTION("only the number is consumed") {
+    emio::reader reader{"1.5e3x 2e 3.e-"};
+    CHECK(reader.parse_float<double>() == 1.5e3);
+    CHECK(reader.view_remaining() == "x 2e 3.e-");
+    reader.pop(2);
+    CHECK(reader.parse_float<double>() == 2.0);
+    CHECK(reader.view_remaining() == "e 3.e-");
+    reader.pop(2);
+    CHECK(reader.parse_float<double>() == 3.0);
+    CHECK(reader.view_remaining() == "e-");
+  }
+
+  SECTION("invalid input") {
+    CHECK(emio::reader{""}.parse_float<double>() == emio::err::eof);
+    CHECK(emio::reader{"-"}.parse_float<double>() == emio::err::eof);
+    CHECK(emio::reader{"."}.parse_float<double>() == emio::err::invalid_data);
+    CHECK(emio::reader{"e5"}.parse_float<double>() == emio::err::invalid_data);
+    CHECK(emio::reader{"in"}.parse_float<double>() == emio::err::invalid_data);
+    CHECK(emio::reader{"1.8e308"}.parse_float<double>() == emio::err::out_of_range);
+    CHECK(emio::reader{"-1e39"}.parse_float<float>() == emio::err::out_of_range);
+  }
+
+  SECTION("a failed parse_float keeps previous read position") {
+    emio::reader reader{"abc -1e999"};
+    CHECK(reader.read_n_chars(4) == "abc ");
+    CHECK(reader.parse_float<double>() == emio::err::out_of_range);
+    CHECK(reader.view_remaining() == "-1e999");
+  }
+
+  SECTION("compile-time") {
+    constexpr bool success = [] {
+      emio::reader reader{"392.65 -1e-5"};
+      const bool first = reader.parse_float<double>() == 392.65;
+      reader.pop();
+      return first && reader.parse_float<float>() == -1e-5F;
+    }();
+    STATIC_CHECK(success);
+  }
+}
+
 TEST_CASE("reader::read_until", "[reader]") {
   SECTION("read_until_char") {
     emio::reader reader{"a12bcd"};
@@ -3,6 +3,8 @@
 
 // Other includes.
 #include <catch2/catch_test_macros.hpp>
+#include <emio/format.hpp>
+#include <string>
 
 #include "integer_ranges.hpp"
 
@@ -338,6 +340,35 @@ TEST_CASE("scan integral of different types", "[scan]") {
   emio::test::apply_integer_ranges(range_check);
 }
 
+#if defined(EMIO_TEST_HAS_INT128)
+
+TEST_CASE("scan 128-bit integers", "[scan]") {
+  // Test strategy:
+  // * Scan 128-bit integers in different bases.
+  // Expected: The values are correctly parsed and overflows are detected.
+
+  using emio::test::int128_t;
+  using emio::test::uint128_t;
+
+  uint128_t u{};
+  int128_t i{};
+  REQUIRE(emio::scan("ffffffffffffffffffffffffffffffff", "{:x}", u));
+  CHECK(u == std::numeric_limits<uint128_t>::max());
+  CHECK(emio::scan("100000000000000000000000000000000", "{:x}", u) == emio::err::out_of_range);
+
+  REQUIRE(emio::scan("-0x80000000000000000000000000000000", "{:#x}", i));
+  CHECK(i == std::numeric_limits<int128_t>::min());
+
+  REQUIRE(emio::scan("0b1" + std::string(100, '0'), "{:#b}", u));
+  CHECK(u == static_cast<uint128_t>(1) << 100);
+
+  REQUIRE(emio::scan("18446744073709551616,-18446744073709551617", "{},{}", u, i));
+  CHECK(u == static_cast<uint128_t>(UINT64_MAX) + 1);
+  CHECK(i == -static_cast<int128_t>(UINT64_MAX) - 2);
+}
+
+#endif
+
 TEST_CASE("scan_binary", "[scan]") {
   int val{};
   SECTION("no prefix") {
@@ -597,3 +628,73 @@ TEST_CASE("scan_string", "[scan]") {
   CHECK(!validate_scan_string<std::string>("{:#}"));
   CHECK(!validate_scan_string<std::string>("{:d}"));
 }
+
+TEST_CASE("scan_floating_point", "[scan]") {
+  double val{};
+  float val2{};
+
+  SECTION("general") {
+    REQUIRE(emio::scan("3.14", "{}", val));
+    CHECK(val == 3.14);
+
+    REQUIRE(emio::scan("-1.5e-3", "{:g}", val));
+    CHECK(val == -1.5e-3);
+
+    REQUIRE(emio::scan("42", "{}", val2));
+    CHECK(val2 == 42.0F);
+
+    REQUIRE(emio::scan("x=0.25,y=-inf", "x={},y={}", val, val2));
+    CHECK(val == 0.25);
+    CHECK(val2 == -std::numeric_limits<float>::infinity());
+  }
+  SECTION("fixed") {
+    REQUIRE(emio::scan("2.5", "{:f}", val));
+    CHECK(val == 2.5);
+
+    REQUIRE(emio::scan("2.5e3", "{:f}e3", val));
+    CHECK(val == 2.5);
+  }
+  SECTION("scientific") {
+    REQUIRE(emio::scan("2.5e3", "{:e}", val));
+    CHECK(val == 2.5e3);
+
+    CHECK(emio::scan("2.5", "{:e}", val) == emio::err::invalid_data);
+  }
+  SECTION("with width") {
+    REQUIRE(emio::scan("1.52.4", "{:3}{:3}", val, val2));
+    CHECK(val == 1.5);
+    CHECK(val2 == 2.4F);
+
+    CHECK(emio::scan("1.5x", "{:4}", val) == emio::err::invalid_data);
+    CHECK(emio::scan("1.5", "{:4}", val) == emio::err::eof);
+  }
+  SECTION("invalid number") {
+    CHECK(emio::scan("abc", "{}", val) == emio::err::invalid_data);
+    CHECK(emio::scan("1e39", "{}", val2) == emio::err::out_of_range);
+  }
+  SECTION("round trip") {
+    for (const double expected : {0.1, 1.0 / 3.0, 6.02214076e23, 1e-310, std::numeric_limits<double>::max()}) {
+      const std::string str = emio::format("{}", expected);
+      REQUIRE(emio::scan(str, "{}", val));
+      CHECK(val == expected);
+    }
+  }
+  SECTION("compile-time") {
+    constexpr bool success = [] {
+      double d{};
+      float f{};
+      return emio::scan("1.25 -2e-2", "{} {}", d, f) && d == 1.25 && f == -2e-2F;
+    }();
+    STATIC_CHECK(success);
+  }
+  SECTION("validation") {
+    CHECK(validate_scan_string<double>("{}"));
+    CHECK(validate_scan_string<double>("{:e}"));
+    CHECK(validate_scan_string<double>("{:f}"));
+    CHECK(validate_scan_string<float>("{:5g}"));
+    CHECK(!validate_scan_string<double>("{:#}"));
+    CHECK(!validate_scan_string<double>("{:a}"));
+    CHECK(!validate_scan_string<double>("{:d}"));
+    CHECK(!validate_scan_string<float>("{:E}"));
+  }
+}
@@ -0,0 +1,165 @@
+// Unit under test.
+#include <emio/stream_reader.hpp>
+
+// Other includes.
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <string>
+
+namespace {
+
+// Returns a callback which provides the input in chunks of the given size.
+auto make_chunked_source(std::string_view input, size_t chunk_size) {
+  return [input, chunk_size](std::span<char> area) mutable noexcept -> emio::result<size_t> {
+    const size_t cnt = std::min({chunk_size, area.size(), input.size()});
+    std::copy_n(input.data(), cnt, area.data());
+    input.remove_prefix(cnt);
+    return cnt;
+  };
+}
+
+}  // namespace
+
+TEST_CASE("stream_reader reads across chunk boundaries", "[stream_reader]") {
+  // Test strategy:
+  // * Read lines, integers and chars from a callback source providing the input in chunks of different sizes.
+  // Expected: The results are independent of the chunk size.
+
+  const size_t chunk_size = GENERATE(1U, 2U, 3U, 7U, 64U);
+  INFO("chunk size: " << chunk_size);
+
+  emio::callback_stream_reader<decltype(make_chunked_source("", 0)), 16> rdr{
+      make_chunked_source("first line\n123456789 -42\nx\n\nlast line", chunk_size)};
+
+  CHECK(!rdr.eof());
+  CHECK(rdr.read_line() == "first line");
+  CHECK(rdr.parse_int<int>() == 123456789);
+  CHECK(rdr.read_if_match_char(' ') == ' ');
+  CHECK(rdr.parse_int<int>() == -42);
+  CHECK(rdr.read_if_match_str("\nx") == "\nx");
+  CHECK(rdr.peek() == '\n');
+  CHECK(rdr.read_char() == '\n');
+  CHECK(rdr.read_line() == "");
+  CHECK(rdr.read_n_chars(4) == "last");
+  CHECK(rdr.read_until_none_of(" ", {.keep_delimiter = true}) == " ");
+  CHECK(rdr.read_line() == "line");
+  CHECK(rdr.eof());
+  CHECK(rdr.read_line() == emio::err::eof);
+  CHECK(rdr.read_char() == emio::err::eof);
+}
+
+TEST_CASE("stream_reader read_until", "[stream_reader]") {
+  // Test strategy:
+  // * Read until delimiters which are split across chunks with different read until options.
+  // Expected: The delimiters are found as if the input were contiguous.
+
+  const size_t chunk_size = GENERATE(1U, 2U, 5U, 64U);
+  INFO("chunk size: " << chunk_size);
+
+  emio::callback_stream_reader<decltype(make_chunked_source("", 0)), 16> rdr{
+      make_chunked_source("key=value;;other:data", chunk_size)};
+
+  CHECK(rdr.read_until_char('=', {.include_delimiter = true}) == "key=");
+  CHECK(rdr.read_until_str(";;", {.keep_delimiter = true}) == "value");
+  CHECK(rdr.read_until_none_of(";", {.keep_delimiter = true}) == ";;");
+  CHECK(rdr.read_until_any_of("-", {.ignore_eof = true}) == emio::err::invalid_data);
+  CHECK(rdr.read_until_any_of(":") == "other");
+  CHECK(rdr.read_until_char('-') == "data");
+  CHECK(rdr.eof());
+}
+
+TEST_CASE("scan_from stream_reader", "[stream_reader]") {
+  // Test strategy:
+  // * Scan records from a callback source providing the input in chunks of different sizes.
+  // Expected: The scanned values are independent of the chunk size.
+
+  const size_t chunk_size = GENERATE(1U, 3U, 64U);
+  INFO("chunk size: " << chunk_size);
+
+  emio::callback_stream_reader<decltype(make_chunked_source("", 0)), 32> rdr{
+      make_chunked_source("12345 abc 0x1f\n-7 xyz 0xff\n99", chunk_size)};
+
+  int a{};
+  char b{};
+  unsigned int c{};
+  REQUIRE(emio::scan_from(rdr, "{} a{}c {:#x}\n", a, b, c));
+  CHECK(a == 12345);
+  CHECK(b == 'b');
+  CHECK(c == 0x1f);
+
+  // Failing scan consumes nothing.
+  CHECK(emio::scan_from(rdr, "{} a", a) == emio::err::invalid_data);
+
+  REQUIRE(emio::scan_from(rdr, "{} x{}z {:#x}\n", a, b, c));
+  CHECK(a == -7);
+  CHECK(b == 'y');
+  CHECK(c == 0xff);
+
+  REQUIRE(emio::scan_from(rdr, "{}", a));
+  CHECK(a == 99);
+  CHECK(rdr.eof());
+}
+
+TEST_CASE("stream_reader with too small cache", "[stream_reader]") {
+  // Test strategy:
+  // * Read a line and chars which are longer than the cache.
+  // * Read chars which fill the cache exactly.
+  // Expected: The reads longer than the cache fail with out_of_range. Shorter reads succeed afterwards.
+
+  emio::callback_stream_reader<decltype(make_chunked_source("", 0)), 8> rdr{
+      make_chunked_source("0123456789\nab", 3)};
+
+  CHECK(rdr.read_line() == emio::err::out_of_range);
+  CHECK(rdr.read_n_chars(9) == emio::err::out_of_range);
+  CHECK(rdr.read_n_chars(8) == "01234567");
+  CHECK(rdr.read_line() == "89");
+  CHECK(rdr.read_line() == "ab");
+}
+
+TEST_CASE("stream_reader with failing source", "[stream_reader]") {
+  // Test strategy:
+  // * Read from a callback source which fails after the first chunk.
+  // Expected: The error is propagated if more input is required.
+
+  bool first = true;
+  emio::callback_stream_reader rdr{[&first](std::span<char> area) noexcept -> emio::result<size_t> {
+    if (!std::exchange(first, false)) {
+      return emio::err::eof;
+    }
+    area[0] = 'a';
+    area[1] = '\n';
+    area[2] = 'b';
+    return 3U;
+  }};
+
+  CHECK(rdr.read_line() == "a");
+  CHECK(rdr.read_line() == emio::err::eof);
+  CHECK(rdr.read_char() == 'b');
+  CHECK(rdr.read_char() == emio::err::eof);
+}
+
+TEST_CASE("file_stream_reader", "[stream_reader]") {
+  // Test strategy:
+  // * Write lines into a temporary file and read them again with a file_stream_reader with a small cache.
+  // Expected: All lines are read.
+
+  std::FILE* tmpf = std::tmpfile();
+  REQUIRE(tmpf);
+
+  std::string expected;
+  for (int i = 0; i < 1000; i++) {
+    expected += std::to_string(i) + ",line\n";
+  }
+  REQUIRE(std::fwrite(expected.data(), 1, expected.size(), tmpf) == expected.size());
+  std::rewind(tmpf);
+
+  emio::file_stream_reader<64> rdr{tmpf};
+  for (int i = 0; i < 1000; i++) {
+    int value{};
+    REQUIRE(emio::scan_from(rdr, "{},line\n", value));
+    CHECK(value == i);
+  }
+  CHECK(rdr.eof());
+
+  std::fclose(tmpf);
+}
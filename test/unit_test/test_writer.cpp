@@ -5,6 +5,8 @@
 #include <catch2/catch_test_macros.hpp>
 #include <functional>
 
+#include "integer_ranges.hpp"
+
 using namespace std::string_view_literals;
 
 namespace {
@@ -114,6 +116,15 @@ TEST_CASE("writer", "[writer]") {
     CHECK(writer.write_int(0, {.base = 36}));
     CHECK(buf.view() == "00000");
   }
+#if defined(EMIO_TEST_HAS_INT128)
+  SECTION("write_int 128-bit") {
+    CHECK(writer.write_int(std::numeric_limits<emio::test::int128_t>::min()));
+    CHECK(buf.view() == "-170141183460469231731687303715884105728");
+
+    CHECK(writer.write_int(std::numeric_limits<emio::test::uint128_t>::max(), {.base = 36}));
+    CHECK(buf.view() == "-170141183460469231731687303715884105728f5lxx1zz5pnorynqglhzmsp33");
+  }
+#endif
 }
 
 TEST_CASE("writer with cached buffer", "[writer]") {